@@ -0,0 +1,104 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: slab allocator for the nodes of linked structures, hands out nodes of type T from contiguous blocks
+			 every block doubles the size of the previous one up to max_block slots, released nodes are recycled
+			 through a freelist threaded through their own storage, memory goes back to the system only when
+			 the slab is destroyed
+			 a slab is not thread safe
+Operations: allocate()	 -> O(1) (amortized time)
+			release()	 -> O(1)
+			deallocate() -> O(1)
+*/
+
+#include <cstddef>
+
+template <class T>
+
+class slab final {
+
+	//Storage for a single node, doubles as a freelist link while the node is not in use
+	private: union slot {
+		T value;
+		slot* next_free;
+
+		slot() {}
+		~slot() {}
+	};
+
+	//Number of usable slots in the first block, each new block doubles it up to max_block
+	private: static const size_t min_block = 32;
+	private: static const size_t max_block = 4096;
+
+	//Fields_____________________________________
+
+	//Most recently allocated block, the first slot of every block links to the previously allocated block
+	private: slot* blocks = nullptr;
+
+	//Number of usable slots of the next block to be allocated
+	private: size_t block_size = min_block;
+
+	//Next never used slot and end of the most recent block
+	private: slot* bump = nullptr;
+	private: slot* bump_end = nullptr;
+
+	//Released slots, ready to be handed out again
+	private: slot* free_list = nullptr;
+
+	//Methods_____________________________________
+
+	//Default constructor, no memory is taken before the first allocate()
+	public: slab() {}
+
+	//Blocks are owned by the slab, copying it would free them twice
+	public: slab(const slab&) = delete;
+	public: slab& operator=(const slab&) = delete;
+
+	//Destructor, frees every block, nodes still in use must have been destroyed by their owner
+	public: ~slab() {
+		while (blocks != nullptr) {
+			slot* next = blocks->next_free;
+			delete[] blocks;
+			blocks = next;
+		}
+	}
+
+	//Returns uninitialized memory for one node
+	public: T* allocate() {
+		slot* s;
+		if (free_list != nullptr) {
+			s = free_list;
+			free_list = s->next_free;
+		}
+		else {
+			if (bump == bump_end) newBlock();
+			s = bump++;
+		}
+		return &s->value;
+	}
+
+	//Destroy the node and recycle its memory
+	public: void release(T* p) {
+		p->~T();
+		deallocate(p);
+	}
+
+	//Recycle memory from allocate() that holds no node, as when constructing the node threw
+	public: void deallocate(T* p) {
+		slot* s = reinterpret_cast<slot*>(p);
+		s->next_free = free_list;
+		free_list = s;
+	}
+
+	//Helpers______________________________________________________
+
+	private: void newBlock() {
+		slot* block = new slot[block_size + 1];
+		block->next_free = blocks;
+		blocks = block;
+		bump = block + 1;
+		bump_end = bump + block_size;
+		if (block_size < max_block) block_size *= 2;
+	}
+};
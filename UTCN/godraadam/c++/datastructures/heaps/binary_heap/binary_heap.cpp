@@ -0,0 +1,282 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: standard, generic binary heap implementation using an array as underlying container
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (as with std::priority_queue, std::less gives a max-heap and std::greater a min-heap)
+			 sifting is iterative and keeps a hole that items are moved into, instead of swapping,
+			 the sifting itself works on any array and lives in heapSift, shared with heapView
+			 sifting down is done bottom-up (Floyd): the hole is first moved down to a leaf along the higher
+			 priority children with one comparison per level, then the item sifts up from there, which is short
+			 since items taken from the bottom of the heap usually belong near the bottom
+			 push_bulk() appends a batch and, when it is large, re-heapifies only the ancestors of the new items
+			 the array is uninitialized memory, items are constructed in place and destroyed when popped
+			 the array grows by doubling as needed, items are moved over, max_size only limits how far it may grow
+			 a heap created with shrink set halves its array whenever fewer than a quarter of it is in use,
+			 so its memory follows the number of live items instead of the peak
+Operations: push()	-> O(log n) (amortized time)
+			emplace() -> O(log n) (amortized time)
+			pop()	-> O(log n) (amortized time with shrink set)
+			popAndPush() -> O(log n) (instead of 2* O(log n) for pop() and then push())
+			push_bulk() -> O(min(k log n, n + k))
+			peek()	-> O(1)
+			heapify(array[n]) -> O(n)
+			reserve() -> O(n)
+			trim()	-> O(n)
+			size()	-> O(1)
+			capacity() -> O(1)
+			empty()	-> O(1)
+			full()	-> O(1)
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+//Sifting on a plain array, shared by binaryHeap and heapView
+class heapSift final {
+
+	template <class T, class Compare> friend class binaryHeap;
+	template <class T, class Compare> friend class heapView;
+
+	//Move item up from the hole at given index of heap, pulling parents down until its place is found above top
+	private: template<class T, class Compare> static void up(T* heap, size_t hole, T item, size_t top, Compare& compare) {
+		while (hole > top) {
+			size_t parent = (hole - 1) / 2;
+			if (!compare(heap[parent], item)) break;
+			heap[hole] = std::move(heap[parent]);
+			hole = parent;
+		}
+		heap[hole] = std::move(item);
+	}
+
+	//Move the hole at given index of a heap of size items down to a leaf, pulling the higher priority child up
+	//on each level, then sift item up from that leaf, no higher than where the hole started
+	private: template<class T, class Compare> static void down(T* heap, size_t size, size_t hole, T item, Compare& compare) {
+		size_t top = hole;
+		size_t child;
+		while ((child = 2 * hole + 1) + 1 < size) {
+			if (compare(heap[child], heap[child + 1])) child++;
+			heap[hole] = std::move(heap[child]);
+			hole = child;
+		}
+		if (child < size) {
+			heap[hole] = std::move(heap[child]);
+			hole = child;
+		}
+		up(heap, hole, std::move(item), top, compare);
+	}
+};
+
+template <class T, class Compare = std::less<T>>
+
+class binaryHeap final {
+
+	//Size of the array of an empty heap
+	private: static constexpr size_t min_capacity = 16;
+
+	//Fields_____________________________________
+
+	//Maximum number of items this heap can hold
+	private: size_t max_size = SIZE_MAX;
+
+	//Current number of items in the heap
+	private: size_t _size = 0;
+
+	//Number of items the array has room for
+	private: size_t _capacity = 0;
+
+	//Halve the array when occupancy falls below a quarter
+	private: bool shrink = false;
+
+	//Actual container to store the items
+	private: T* heap = nullptr;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//Default constructor
+	public: binaryHeap() {
+		relocate(min_capacity);
+	}
+
+	//Constructor with custom maximum size, optionally shrinking as items are popped
+	public: binaryHeap(size_t max_size, bool shrink = false) {
+		this->max_size = max_size;
+		this->shrink = shrink;
+		relocate(min_capacity < max_size ? min_capacity : max_size);
+	}
+
+	//Construct heap from given array
+	public: binaryHeap(T* arr, size_t size) : binaryHeap(arr, size, SIZE_MAX) {}
+
+	//Construct heap from given array and set maximum size
+	public: binaryHeap(T* arr, size_t size, size_t max_size) {
+		if (size > max_size) throw std::length_error("Heap is full!");
+		this->max_size = max_size;
+		relocate(size > min_capacity || max_size < min_capacity ? size : min_capacity);
+		for (; _size < size; _size++) new (heap + _size) T(arr[_size]);
+
+		//sift down each internal node to ensure heap property
+		heapify(0, _size);
+	}
+
+	//The container is owned by the heap, copying it would free it twice
+	public: binaryHeap(const binaryHeap&) = delete;
+	public: binaryHeap& operator=(const binaryHeap&) = delete;
+
+	//Destructor, destroys the remaining items and releases the container
+	public: ~binaryHeap() {
+		for (size_t i = 0; i < _size; i++) heap[i].~T();
+		std::allocator<T>().deallocate(heap, _capacity);
+	}
+
+	//Insert new item to heap while preserving heap property
+	public: void push(T item) {
+		emplace(std::move(item));
+	}
+
+	//Construct new item from the given arguments and insert it while preserving heap property
+	public: template<class... Args> void emplace(Args&&... args) {
+		if (full()) throw std::length_error("Heap is full!");
+		if (_size == _capacity) grow(_size + 1);
+		new (heap + _size) T(std::forward<Args>(args)...);
+		heapSift::up(heap, _size, std::move(heap[_size]), 0, compare);
+		_size++;
+	}
+
+	//Insert all items of [first, last) while preserving heap property
+	//The batch is appended, then sifted up item by item while the worst case of that, count * depth,
+	//stays below the 2 * size comparisons of re-heapifying the ancestors of the new items
+	public: template<class Iterator> void push_bulk(Iterator first, Iterator last) {
+		size_t count = std::distance(first, last);
+		if (count > max_size - _size) throw std::length_error("Heap is full!");
+		if (count > _capacity - _size) grow(_size + count);
+		size_t from = _size;
+		for (; first != last; ++first) new (heap + _size++) T(*first);
+
+		size_t depth = 0;
+		for (size_t n = _size; n > 1; n >>= 1) depth++;
+		if (count * depth <= 2 * _size) {
+			for (size_t i = from; i < _size; i++) heapSift::up(heap, i, std::move(heap[i]), 0, compare);
+		}
+		else heapify(from, _size);
+	}
+
+	//Remove and return root of the heap while preserving heap property
+	public: T pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		if (--_size > 0) heapSift::down(heap, _size, 0, std::move(heap[_size]), compare);
+		heap[_size].~T();
+		if (shrink && _size < _capacity / 4 && _capacity > min_capacity) relocate(std::max(_capacity / 2, min_capacity));
+		return ret;
+	}
+
+	//More efficient than pop() and then push() applied separately
+	public: T popAndPush(T item) {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		heapSift::down(heap, _size, 0, std::move(item), compare);
+		return ret;
+	}
+
+	//Return root of the heap without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return heap[0];
+	}
+
+	//Make room for at least capacity items without growing again
+	public: void reserve(size_t capacity) {
+		if (capacity > max_size) throw std::length_error("Heap is full!");
+		if (capacity > _capacity) relocate(capacity);
+	}
+
+	//Release the unused part of the array
+	public: void trim() {
+		relocate(_size);
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns true only of the number of items inside heap has reached maximum capacity
+	public: bool full() {
+		return _size == max_size;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Returns maximum capacity of the heap
+	public: size_t maxSize() {
+		return max_size;
+	}
+
+	//Returns the number of items the heap can hold before growing
+	public: size_t capacity() {
+		return _capacity;
+	}
+
+	//Helpers______________________________________________________
+
+	//Grow the array geometrically to room for at least needed items, no further than max_size
+	private: void grow(size_t needed) {
+		size_t capacity = _capacity > max_size / 2 ? max_size : _capacity * 2;
+		relocate(capacity > needed ? capacity : needed);
+	}
+
+	//Move the items into a new array with room for capacity items
+	private: void relocate(size_t capacity) {
+		T* _heap = std::allocator<T>().allocate(capacity);
+		for (size_t i = 0; i < _size; i++) {
+			new (_heap + i) T(std::move(heap[i]));
+			heap[i].~T();
+		}
+		if (heap != nullptr) std::allocator<T>().deallocate(heap, _capacity);
+		heap = _heap;
+		_capacity = capacity;
+	}
+
+	//Return index of left child inside array
+	private: size_t left(size_t index) {
+		return 2 * index + 1;
+	}
+
+	//Return index of parent inside array
+	private: size_t parent(size_t index) {
+		return (index - 1) / 2;
+	}
+
+	//Restore heap property after the items in [from, to) were placed without sifting
+	//the range and every level of its ancestors is sifted down, each node after its children
+	private: void heapify(size_t from, size_t to) {
+		if (from >= to) return;
+		size_t low = from, high = to - 1;
+
+		//Nodes from done onwards were already sifted
+		size_t done = to;
+		while (true) {
+			for (size_t i = (high < done ? high : done - 1) + 1; i-- > low;)
+				if (left(i) < _size) heapSift::down(heap, _size, i, std::move(heap[i]), compare);
+			if (low == 0) break;
+			done = low;
+			low = parent(low);
+			high = parent(high);
+		}
+	}
+};
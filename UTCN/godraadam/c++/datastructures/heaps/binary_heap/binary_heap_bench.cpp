@@ -0,0 +1,165 @@
+/*
+Author: godraadam @ utcn 2019
+Description: benchmark of the hole-based binary heap against the previous swap-based maxHeap
+			 counts the moves and copies of items and the comparisons per push and per pop and measures the time
+			 the second table counts the comparisons of push_bulk() against pushing the batch item by item,
+			 for random batches and for ascending ones, where every push sifts up to the root
+Build: g++ -O2 -std=c++17 binary_heap_bench.cpp -o binary_heap_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "binary_heap.cpp"
+
+//Item counting every time it is moved, copied or compared
+struct counted {
+	static inline size_t moves = 0;
+	static inline size_t compares = 0;
+
+	long key = 0;
+	std::string payload;
+
+	counted(long key) : key(key), payload(24, 'x') {}
+	counted(const counted& o) : key(o.key), payload(o.payload) { moves++; }
+	counted(counted&& o) noexcept : key(o.key), payload(std::move(o.payload)) { moves++; }
+	counted& operator=(const counted& o) { key = o.key; payload = o.payload; moves++; return *this; }
+	counted& operator=(counted&& o) noexcept { key = o.key; payload = std::move(o.payload); moves++; return *this; }
+
+	bool operator<(const counted& o) const { compares++; return key < o.key; }
+	bool operator>(const counted& o) const { compares++; return key > o.key; }
+};
+
+//The previous max-heap: recursive heapify and three-move swaps
+template <class T>
+
+class swapHeap final {
+
+	private: size_t max_size;
+	private: size_t _size = 0;
+	private: T* heap;
+
+	public: swapHeap(size_t max_size) : max_size(max_size) {
+		heap = std::allocator<T>().allocate(max_size);
+	}
+
+	public: ~swapHeap() {
+		for (size_t i = 0; i < _size; i++) heap[i].~T();
+		std::allocator<T>().deallocate(heap, max_size);
+	}
+
+	public: void push(T item) {
+		if (_size == max_size) throw std::length_error("Heap is full!");
+		new (heap + _size) T(std::move(item));
+		_size++;
+
+		size_t index = _size - 1;
+		size_t _parent = parent(index);
+		while (index > 0 and heap[_parent] < heap[index]) {
+			swap(heap[index], heap[_parent]);
+			index = _parent;
+			_parent = parent(index);
+		}
+	}
+
+	public: T pop() {
+		if (_size == 0) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		if (--_size > 0) {
+			heap[0] = std::move(heap[_size]);
+			heapify(0);
+		}
+		heap[_size].~T();
+		return ret;
+	}
+
+	private: size_t parent(size_t index) {
+		return index > 0 ? (index - 1) / 2 : 0;
+	}
+
+	private: void heapify(size_t index) {
+		size_t _left = 2 * index + 1;
+		size_t _right = 2 * index + 2;
+		size_t max = index;
+
+		if (_left < _size && heap[_left] > heap[max]) max = _left;
+		if (_right < _size && heap[_right] > heap[max]) max = _right;
+
+		if (max != index) {
+			swap(heap[max], heap[index]);
+			heapify(max);
+		}
+	}
+
+	private: void swap(T& a, T& b) {
+		T c = std::move(a);
+		a = std::move(b);
+		b = std::move(c);
+	}
+};
+
+//Push all keys then pop them all, prints moves and comparisons per operation and total time
+template <class H>
+static void run(const char* name, const std::vector<long>& keys) {
+	H heap(keys.size());
+	long sink = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	counted::moves = 0;
+	counted::compares = 0;
+	for (long key : keys) heap.push(counted(key));
+	double push_moves = (double)counted::moves / keys.size();
+	double push_compares = (double)counted::compares / keys.size();
+
+	counted::moves = 0;
+	counted::compares = 0;
+	for (size_t i = 0; i < keys.size(); i++) sink += heap.pop().key;
+	double pop_moves = (double)counted::moves / keys.size();
+	double pop_compares = (double)counted::compares / keys.size();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%-22s %10zu %11.2f %11.2f %11.2f %11.2f %10.1f   (%ld)\n", name, keys.size(), push_moves, pop_moves, push_compares, pop_compares, ms, sink);
+}
+
+//Heap of n random items, then a batch of k more, pushed one by one and with push_bulk()
+static void bulk(size_t n, size_t k, bool ascending, std::mt19937_64& rng) {
+	std::vector<counted> base, batch;
+	for (size_t i = 0; i < n; i++) base.emplace_back((long)(rng() % 1000000007));
+	for (size_t i = 0; i < k; i++) batch.emplace_back(ascending ? 1000000007 + (long)i : (long)(rng() % 1000000007));
+
+	binaryHeap<counted> single(n + k), together(n + k);
+	single.push_bulk(base.begin(), base.end());
+	together.push_bulk(base.begin(), base.end());
+
+	counted::compares = 0;
+	for (const counted& item : batch) single.push(item);
+	size_t single_compares = counted::compares;
+
+	counted::compares = 0;
+	together.push_bulk(batch.begin(), batch.end());
+	size_t bulk_compares = counted::compares;
+
+	std::printf("%10zu %10zu %10s %14zu %14zu\n", n, k, ascending ? "ascending" : "random", single_compares, bulk_compares);
+}
+
+int main() {
+	std::mt19937_64 rng(42);
+	std::printf("%-22s %10s %11s %11s %11s %11s %10s\n", "heap", "items", "moves/push", "moves/pop", "cmp/push", "cmp/pop", "time (ms)");
+	for (size_t n : { 1000, 100000, 1000000 }) {
+		std::vector<long> keys(n);
+		for (long& key : keys) key = (long)(rng() % 1000000007);
+		run<swapHeap<counted>>("swap-based maxHeap", keys);
+		run<binaryHeap<counted>>("hole-based binaryHeap", keys);
+	}
+
+	std::printf("\n%10s %10s %10s %14s %14s\n", "heap", "batch", "keys", "cmp push()", "cmp push_bulk");
+	for (size_t n : { 1000, 1000000 }) {
+		for (size_t k : { n / 100, n / 4, n }) {
+			bulk(n, k, false, rng);
+			bulk(n, k, true, rng);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: generic d-ary heap implementation using an array as underlying container, arity given at compile time
+			 a wider node makes the heap shallower, so a sift down touches fewer cache lines for more comparisons
+			 the array is offset so that the children of every node start on a boundary of arity items,
+			 with 8-byte keys and arity 8 each block of children is exactly one cache line
+			 8-ary heaps of int32, uint32, float or double ordered by std::less or std::greater pick the best
+			 child with AVX2 min/max over the whole block when compiled with AVX2 enabled (-mavx2 / -march=native),
+			 other 8-ary heaps of arithmetic keys use a branchless scan of the block
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+Operations: push()	-> O(log_d n)
+			emplace() -> O(log_d n)
+			pop()	-> O(d log_d n)
+			popAndPush() -> O(d log_d n)
+			peek()	-> O(1)
+			heapify(array[n]) -> O(n)
+			size()	-> O(1)
+			empty()	-> O(1)
+			full()	-> O(1)
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+template <class T, size_t arity = 4, class Compare = std::less<T>>
+
+class dAryHeap final {
+
+	static_assert(arity >= 2, "Heap arity must be at least 2!");
+
+	//Alignment of the container, a cache line
+	private: static const size_t alignment = 64;
+
+	//True if the heap keeps the largest / the smallest item on top of plain arithmetic keys
+	private: static constexpr bool maximum = std::is_arithmetic<T>::value && std::is_same<Compare, std::less<T>>::value;
+	private: static constexpr bool minimum = std::is_arithmetic<T>::value && std::is_same<Compare, std::greater<T>>::value;
+
+	//Fields_____________________________________
+
+	//Maximum number of items this heap can hold
+	private: size_t max_size = UINT16_MAX;
+
+	//Current number of items in the heap
+	private: size_t _size = 0;
+
+	//Start of the allocated memory, aligned to a cache line
+	private: T* storage;
+
+	//Actual container to store the items, offset from storage so that child blocks are aligned
+	private: T* heap;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//Default constructor
+	public: dAryHeap() {
+		allocate();
+	}
+
+	//Constructor with custom capacity
+	public: dAryHeap(size_t max_size) {
+		this->max_size = max_size;
+		allocate();
+	}
+
+	//Construct heap from given array and set capacity
+	public: dAryHeap(T* arr, size_t size, size_t max_size = UINT16_MAX) {
+		if (size > max_size) throw std::length_error("Heap is full!");
+		this->max_size = max_size;
+		allocate();
+		for (; _size < size; _size++) new (heap + _size) T(arr[_size]);
+
+		//sift down each internal node to ensure heap property
+		if (_size > 1)
+			for (size_t i = parent(_size - 1) + 1; i-- > 0;) siftDown(i, std::move(heap[i]));
+	}
+
+	//The container is owned by the heap, copying it would free it twice
+	public: dAryHeap(const dAryHeap&) = delete;
+	public: dAryHeap& operator=(const dAryHeap&) = delete;
+
+	//Destructor, destroys the remaining items and releases the container
+	public: ~dAryHeap() {
+		for (size_t i = 0; i < _size; i++) heap[i].~T();
+		::operator delete(storage, std::align_val_t(alignment));
+	}
+
+	//Insert new item to heap while preserving heap property
+	public: void push(T item) {
+		emplace(std::move(item));
+	}
+
+	//Construct new item from the given arguments and insert it while preserving heap property
+	public: template<class... Args> void emplace(Args&&... args) {
+		if (full()) throw std::length_error("Heap is full!");
+		new (heap + _size) T(std::forward<Args>(args)...);
+		siftUp(_size, std::move(heap[_size]));
+		_size++;
+	}
+
+	//Remove and return root of the heap while preserving heap property
+	public: T pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		if (--_size > 0) siftDown(0, std::move(heap[_size]));
+		heap[_size].~T();
+		return ret;
+	}
+
+	//More efficient than pop() and then push() applied separately
+	public: T popAndPush(T item) {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		siftDown(0, std::move(item));
+		return ret;
+	}
+
+	//Return root of the heap without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return heap[0];
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns true only of the number of items inside heap has reached maximum capacity
+	public: bool full() {
+		return _size == max_size;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Returns maximum capacity of the heap
+	public: size_t maxSize() {
+		return max_size;
+	}
+
+	//Helpers______________________________________________________
+
+	//Allocate aligned memory for max_size items, item i + 1 lands on a multiple of arity
+	private: void allocate() {
+		storage = static_cast<T*>(::operator new((max_size + arity - 1) * sizeof(T), std::align_val_t(alignment)));
+		heap = storage + (arity - 1);
+	}
+
+	//Return index of first child inside array
+	private: size_t child(size_t index) {
+		return arity * index + 1;
+	}
+
+	//Return index of parent inside array
+	private: size_t parent(size_t index) {
+		return (index - 1) / arity;
+	}
+
+	//Move item up from the hole at given index, pulling parents down until its place is found
+	private: void siftUp(size_t hole, T item) {
+		while (hole > 0) {
+			size_t _parent = parent(hole);
+			if (!compare(heap[_parent], item)) break;
+			heap[hole] = std::move(heap[_parent]);
+			hole = _parent;
+		}
+		heap[hole] = std::move(item);
+	}
+
+	//Move item down from the hole at given index, pulling the best child up until its place is found
+	private: void siftDown(size_t hole, T item) {
+		size_t first;
+		while ((first = child(hole)) < _size) {
+			size_t count = _size - first < arity ? _size - first : arity;
+			size_t best = first + (count == arity ? bestOfBlock(heap + first) : bestOf(heap + first, count));
+			if (!compare(item, heap[best])) break;
+			heap[hole] = std::move(heap[best]);
+			hole = best;
+		}
+		heap[hole] = std::move(item);
+	}
+
+	//Returns the offset of the highest priority item among count items
+	private: size_t bestOf(T* items, size_t count) {
+		size_t best = 0;
+		for (size_t i = 1; i < count; i++)
+			if (compare(items[best], items[i])) best = i;
+		return best;
+	}
+
+	//Returns the offset of the highest priority item in a full block of arity children
+	private: size_t bestOfBlock(T* items) {
+		if constexpr (arity == 8 && (maximum || minimum)) {
+#if defined(__AVX2__)
+			if constexpr (std::is_same<T, int32_t>::value) return bestOfInt32(items);
+			if constexpr (std::is_same<T, uint32_t>::value) return bestOfUInt32(items);
+			if constexpr (std::is_same<T, float>::value) return bestOfFloat(items);
+			if constexpr (std::is_same<T, double>::value) return bestOfDouble(items);
+#endif
+			//Branchless reduction the compiler can keep in registers, then locate the winner
+			T m = items[0];
+			for (size_t i = 1; i < arity; i++) m = maximum ? (items[i] > m ? items[i] : m) : (items[i] < m ? items[i] : m);
+			for (size_t i = 0; i < arity; i++)
+				if (items[i] == m) return i;
+			return 0;
+		}
+		else return bestOf(items, arity);
+	}
+
+#if defined(__AVX2__)
+	private: static size_t bestOfInt32(T* items) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+		__m256i m = maximum ? _mm256_max_epi32(v, _mm256_permute2x128_si256(v, v, 1)) : _mm256_min_epi32(v, _mm256_permute2x128_si256(v, v, 1));
+		m = maximum ? _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2))) : _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+		m = maximum ? _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1))) : _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+		return __builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m))));
+	}
+
+	private: static size_t bestOfUInt32(T* items) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+		__m256i m = maximum ? _mm256_max_epu32(v, _mm256_permute2x128_si256(v, v, 1)) : _mm256_min_epu32(v, _mm256_permute2x128_si256(v, v, 1));
+		m = maximum ? _mm256_max_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2))) : _mm256_min_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+		m = maximum ? _mm256_max_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1))) : _mm256_min_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+		return __builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m))));
+	}
+
+	private: static size_t bestOfFloat(T* items) {
+		__m256 v = _mm256_loadu_ps(items);
+		__m256 m = maximum ? _mm256_max_ps(v, _mm256_permute2f128_ps(v, v, 1)) : _mm256_min_ps(v, _mm256_permute2f128_ps(v, v, 1));
+		m = maximum ? _mm256_max_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2))) : _mm256_min_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2)));
+		m = maximum ? _mm256_max_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1))) : _mm256_min_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1)));
+		int mask = _mm256_movemask_ps(_mm256_cmp_ps(v, m, _CMP_EQ_OQ));
+		return mask == 0 ? 0 : __builtin_ctz(mask);
+	}
+
+	private: static size_t bestOfDouble(T* items) {
+		__m256d low = _mm256_loadu_pd(items);
+		__m256d high = _mm256_loadu_pd(items + 4);
+		__m256d m = maximum ? _mm256_max_pd(low, high) : _mm256_min_pd(low, high);
+		m = maximum ? _mm256_max_pd(m, _mm256_permute2f128_pd(m, m, 1)) : _mm256_min_pd(m, _mm256_permute2f128_pd(m, m, 1));
+		m = maximum ? _mm256_max_pd(m, _mm256_permute_pd(m, 0x5)) : _mm256_min_pd(m, _mm256_permute_pd(m, 0x5));
+		int mask = _mm256_movemask_pd(_mm256_cmp_pd(low, m, _CMP_EQ_OQ)) | (_mm256_movemask_pd(_mm256_cmp_pd(high, m, _CMP_EQ_OQ)) << 4);
+		return mask == 0 ? 0 : __builtin_ctz(mask);
+	}
+#endif
+};
@@ -0,0 +1,51 @@
+/*
+Author: godraadam @ utcn 2019
+Description: benchmark of the d-ary heap with arity 2, 4 and 8 against the binary heap, int and double keys
+			 fills the heap with n random keys, then runs n popAndPush() steps and finally pops everything
+			 prints nanoseconds per operation, the gap widens once the heap no longer fits in cache
+Build: g++ -O2 -std=c++17 -march=native dary_heap_bench.cpp -o dary_heap_bench
+	   (without -mavx2 / -march=native the 8-ary heap uses the scalar scan)
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../binary_heap/binary_heap.cpp"
+#include "dary_heap.cpp"
+
+//Push all keys, replace the top n times and pop all, returns nanoseconds per operation
+template <class H, class K>
+static double run(const std::vector<K>& keys, double& sink) {
+	H heap(keys.size());
+	auto start = std::chrono::steady_clock::now();
+	for (K key : keys) heap.push(key);
+	for (K key : keys) sink += heap.popAndPush(key);
+	while (!heap.empty()) sink += heap.pop();
+	double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	return ns / (3 * keys.size());
+}
+
+template <class K>
+static void table(const char* type) {
+	std::mt19937_64 rng(42);
+	double sink = 0;
+	std::printf("%s keys, ns/operation\n", type);
+	std::printf("%10s %12s %12s %12s %12s\n", "items", "binaryHeap", "2-ary", "4-ary", "8-ary");
+	for (size_t n : { 1000, 16000, 256000, 1000000, 4000000 }) {
+		std::vector<K> keys(n);
+		for (K& key : keys) key = (K)(rng() % 1000000007);
+		double binary = run<binaryHeap<K>>(keys, sink);
+		double two = run<dAryHeap<K, 2>>(keys, sink);
+		double four = run<dAryHeap<K, 4>>(keys, sink);
+		double eight = run<dAryHeap<K, 8>>(keys, sink);
+		std::printf("%10zu %12.1f %12.1f %12.1f %12.1f\n", n, binary, two, four, eight);
+	}
+	std::printf("(%g)\n\n", sink);
+}
+
+int main() {
+	table<int32_t>("int32");
+	table<double>("double");
+	return 0;
+}
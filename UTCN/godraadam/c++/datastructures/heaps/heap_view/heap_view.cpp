@@ -0,0 +1,124 @@
+/*
+Author: godraadam @ utcn 2019
+Description: non-owning binary heap over an array owned by the caller, nothing is ever allocated or copied
+			 the first size items of the array are heapified in place, the slots up to capacity are spare
+			 room for push(), the array must outlive the view
+			 popped items leave the heap through the slot just past its end, heap_sort() and partial_sort(k)
+			 use this to sort the array in place: the k highest priority items end up at the back of the heap's
+			 range, ordered by Compare, while the rest stays a heap in front of them
+			 sifting is done bottom-up with the heapSift helpers of binaryHeap
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (std::less gives a max-heap and heap_sort() then leaves the array ascending)
+Operations: heapify(array[n]) -> O(n)
+			push()	-> O(log n)
+			pop()	-> O(log n)
+			popAndPush() -> O(log n)
+			peek()	-> O(1)
+			heap_sort() -> O(n log n)
+			partial_sort(k) -> O(k log n)
+			size()	-> O(1)
+			capacity() -> O(1)
+			empty()	-> O(1)
+			full()	-> O(1)
+*/
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "../binary_heap/binary_heap.cpp"
+
+template <class T, class Compare = std::less<T>>
+
+class heapView final {
+
+	//Fields_____________________________________
+
+	//The caller's array
+	private: T* heap;
+
+	//Number of items in the heap, the first _size slots of the array
+	private: size_t _size;
+
+	//Number of slots of the array the heap may use
+	private: size_t _capacity;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//View over the first size items of arr, heapified in place, with room for capacity items
+	public: heapView(T* arr, size_t size, size_t capacity) : heap(arr), _size(size), _capacity(capacity) {
+		if (size > capacity) throw std::length_error("Invalid size!");
+		for (size_t i = _size / 2; i-- > 0;) heapSift::down(heap, _size, i, std::move(heap[i]), compare);
+	}
+
+	//View over a full array
+	public: heapView(T* arr, size_t size) : heapView(arr, size, size) {}
+
+	//Insert new item into the next spare slot while preserving heap property
+	public: void push(T item) {
+		if (full()) throw std::length_error("Heap is full!");
+		heapSift::up(heap, _size, std::move(item), 0, compare);
+		_size++;
+	}
+
+	//Remove and return root of the heap, its slot becomes spare
+	public: T pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		if (--_size > 0) heapSift::down(heap, _size, 0, std::move(heap[_size]), compare);
+		return ret;
+	}
+
+	//More efficient than pop() and then push() applied separately
+	public: T popAndPush(T item) {
+		if (empty()) throw std::length_error("Heap is empty!");
+		T ret = std::move(heap[0]);
+		heapSift::down(heap, _size, 0, std::move(item), compare);
+		return ret;
+	}
+
+	//Return root of the heap without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return heap[0];
+	}
+
+	//Sort the heap's items in place, ordered by Compare, leaving the heap empty
+	public: void heap_sort() {
+		partial_sort(_size);
+	}
+
+	//Move the k highest priority items to the back of the heap's range, ordered by Compare, as pop() would
+	//return them from last to first, the heap keeps the remaining size - k items in front of them
+	public: void partial_sort(size_t k) {
+		if (k > _size) throw std::length_error("Heap is too small!");
+		for (; k > 0; k--) {
+			T top = std::move(heap[0]);
+			if (--_size > 0) heapSift::down(heap, _size, 0, std::move(heap[_size]), compare);
+			heap[_size] = std::move(top);
+		}
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns true only if every slot of the array is in use
+	public: bool full() {
+		return _size == _capacity;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Returns the number of slots of the array the heap may use
+	public: size_t capacity() {
+		return _capacity;
+	}
+};
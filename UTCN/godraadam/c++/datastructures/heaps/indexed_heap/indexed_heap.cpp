@@ -0,0 +1,261 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: generic indexed binary heap, every pushed item gets a handle that stays valid until the item leaves the heap
+			 the keys of items already in the heap can be changed or removed through their handle
+			 the heap array keeps every item next to its handle so that sifting compares neighbouring memory,
+			 a map from handle to position in the heap array is updated whenever an item moves
+			 a handle is reused after its item was popped or erased
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (std::less gives a max-heap and std::greater a min-heap)
+			 decrease_key() and increase_key() compare the key values themselves with operator<, whatever Compare is,
+			 and the item moves whichever way Compare requires (in a min-heap decrease_key() moves it towards the top)
+Operations: push()	-> O(log n)
+			emplace() -> O(log n)
+			pop()	-> O(log n)
+			peek()	-> O(1)
+			topHandle() -> O(1)
+			get()	-> O(1)
+			contains() -> O(1)
+			decrease_key() -> O(log n)
+			increase_key() -> O(log n)
+			update() -> O(log n)
+			erase() -> O(log n)
+			size()	-> O(1)
+			empty()	-> O(1)
+			full()	-> O(1)
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+template <class T, class Compare = std::less<T>>
+
+class indexedHeap final {
+
+	//Position of a handle that is not in the heap
+	private: static const size_t npos = SIZE_MAX;
+
+	//Item together with its handle
+	private: struct entry {
+		T item;
+		size_t handle;
+	};
+
+	//Fields_____________________________________
+
+	//Maximum number of items this heap can hold, handles are in [0, max_size)
+	private: size_t max_size = UINT16_MAX;
+
+	//Current number of items in the heap
+	private: size_t _size = 0;
+
+	//Actual container to store the items
+	private: entry* heap;
+
+	//Position of each handle inside heap, npos if the handle is free
+	private: size_t* position;
+
+	//Stack of handles given back by pop() and erase()
+	private: size_t* free_handles;
+	private: size_t free_count = 0;
+
+	//Handles from here on were never given out
+	private: size_t fresh = 0;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//Default constructor
+	public: indexedHeap() {
+		allocate();
+	}
+
+	//Constructor with custom capacity
+	public: indexedHeap(size_t max_size) {
+		this->max_size = max_size;
+		allocate();
+	}
+
+	//The containers are owned by the heap, copying it would free them twice
+	public: indexedHeap(const indexedHeap&) = delete;
+	public: indexedHeap& operator=(const indexedHeap&) = delete;
+
+	//Destructor, destroys the remaining items and releases the containers
+	public: ~indexedHeap() {
+		for (size_t i = 0; i < _size; i++) heap[i].~entry();
+		std::allocator<entry>().deallocate(heap, max_size);
+		delete[] position;
+		delete[] free_handles;
+	}
+
+	//Insert new item to heap, returns its handle
+	public: size_t push(T item) {
+		return emplace(std::move(item));
+	}
+
+	//Construct new item from the given arguments and insert it, returns its handle
+	public: template<class... Args> size_t emplace(Args&&... args) {
+		if (full()) throw std::length_error("Heap is full!");
+		size_t handle = free_count > 0 ? free_handles[--free_count] : fresh++;
+		new (heap + _size) entry{ T(std::forward<Args>(args)...), handle };
+		siftUp(_size, std::move(heap[_size]));
+		_size++;
+		return handle;
+	}
+
+	//Remove and return root of the heap, its handle becomes free
+	public: T pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return remove(0);
+	}
+
+	//Return root of the heap without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return heap[0].item;
+	}
+
+	//Return the handle of the root of the heap
+	public: size_t topHandle() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return heap[0].handle;
+	}
+
+	//Return the item with the given handle
+	public: T get(size_t handle) {
+		check(handle);
+		return heap[position[handle]].item;
+	}
+
+	//Returns true only if the handle belongs to an item inside the heap
+	public: bool contains(size_t handle) {
+		return handle < fresh && position[handle] != npos;
+	}
+
+	//Lower the key of the item with the given handle, the new key must not be larger than the current one
+	public: void decrease_key(size_t handle, T item) {
+		check(handle);
+		if (std::less<T>()(heap[position[handle]].item, item)) throw std::invalid_argument("New key is larger than the current one!");
+		update(handle, std::move(item));
+	}
+
+	//Raise the key of the item with the given handle, the new key must not be smaller than the current one
+	public: void increase_key(size_t handle, T item) {
+		check(handle);
+		if (std::less<T>()(item, heap[position[handle]].item)) throw std::invalid_argument("New key is smaller than the current one!");
+		update(handle, std::move(item));
+	}
+
+	//Replace the key of the item with the given handle, moving it whichever way the new key requires
+	public: void update(size_t handle, T item) {
+		check(handle);
+		size_t index = position[handle];
+		bool up = compare(heap[index].item, item);
+		if (up) siftUp(index, entry{ std::move(item), handle });
+		else siftDown(index, entry{ std::move(item), handle });
+	}
+
+	//Remove and return the item with the given handle, the handle becomes free
+	public: T erase(size_t handle) {
+		check(handle);
+		return remove(position[handle]);
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns true only of the number of items inside heap has reached maximum capacity
+	public: bool full() {
+		return _size == max_size;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Returns maximum capacity of the heap
+	public: size_t maxSize() {
+		return max_size;
+	}
+
+	//Helpers______________________________________________________
+
+	//Allocate the containers, handles are marked free when first given out
+	private: void allocate() {
+		heap = std::allocator<entry>().allocate(max_size);
+		position = new size_t[max_size];
+		free_handles = new size_t[max_size];
+	}
+
+	//Throw if the handle does not belong to an item inside the heap
+	private: void check(size_t handle) {
+		if (!contains(handle)) throw std::out_of_range("Invalid handle!");
+	}
+
+	//Remove the item at the given position, the last item fills the hole and the handle is freed
+	private: T remove(size_t index) {
+		size_t handle = heap[index].handle;
+		T ret = std::move(heap[index].item);
+		position[handle] = npos;
+		free_handles[free_count++] = handle;
+
+		if (--_size > index) {
+			entry last = std::move(heap[_size]);
+			if (index > 0 && compare(heap[parent(index)].item, last.item)) siftUp(index, std::move(last));
+			else siftDown(index, std::move(last));
+		}
+		heap[_size].~entry();
+		return ret;
+	}
+
+	//Return index of left child inside array
+	private: size_t left(size_t index) {
+		return 2 * index + 1;
+	}
+
+	//Return index of parent inside array
+	private: size_t parent(size_t index) {
+		return (index - 1) / 2;
+	}
+
+	//Move entry into the given slot and record its position
+	private: void place(size_t index, entry&& e) {
+		position[e.handle] = index;
+		heap[index] = std::move(e);
+	}
+
+	//Move entry up from the hole at given index, pulling parents down until its place is found
+	private: void siftUp(size_t hole, entry e) {
+		while (hole > 0) {
+			size_t _parent = parent(hole);
+			if (!compare(heap[_parent].item, e.item)) break;
+			place(hole, std::move(heap[_parent]));
+			hole = _parent;
+		}
+		place(hole, std::move(e));
+	}
+
+	//Move entry down from the hole at given index, pulling the higher priority child up until its place is found
+	private: void siftDown(size_t hole, entry e) {
+		size_t child;
+		while ((child = left(hole)) < _size) {
+			if (child + 1 < _size && compare(heap[child].item, heap[child + 1].item)) child++;
+			if (!compare(e.item, heap[child].item)) break;
+			place(hole, std::move(heap[child]));
+			hole = child;
+		}
+		place(hole, std::move(e));
+	}
+};
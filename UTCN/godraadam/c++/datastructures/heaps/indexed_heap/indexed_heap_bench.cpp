@@ -0,0 +1,131 @@
+/*
+Author: godraadam @ utcn 2019
+Description: dijkstra shortest paths on random sparse graphs, indexed heap with decrease_key against
+			 a minHeap with lazy deletion (push a duplicate on every improvement, skip stale entries when popped)
+			 prints time, pushes, stale pops and the largest heap size reached
+Build: g++ -O2 -std=c++17 indexed_heap_bench.cpp -o indexed_heap_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../binary_min_heap/binary_min_heap.cpp"
+#include "indexed_heap.cpp"
+
+//Graph in compressed adjacency form, edges of node v are in [first[v], first[v + 1])
+struct graph {
+	std::vector<size_t> first;
+	std::vector<uint32_t> target;
+	std::vector<uint32_t> weight;
+};
+
+static graph randomGraph(size_t nodes, size_t degree, std::mt19937_64& rng) {
+	graph g;
+	g.first.resize(nodes + 1);
+	for (size_t v = 0; v <= nodes; v++) g.first[v] = v * degree;
+	for (size_t e = 0; e < nodes * degree; e++) {
+		g.target.push_back((uint32_t)(rng() % nodes));
+		g.weight.push_back((uint32_t)(rng() % 1000 + 1));
+	}
+	return g;
+}
+
+struct stats {
+	double ms = 0;
+	size_t pushes = 0;
+	size_t stale = 0;
+	size_t peak = 0;
+	uint64_t checksum = 0;
+};
+
+static stats indexed(const graph& g) {
+	stats s;
+	size_t nodes = g.first.size() - 1;
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<uint64_t> dist(nodes, UINT64_MAX);
+	std::vector<size_t> handle(nodes, SIZE_MAX);
+	std::vector<uint32_t> node(nodes);
+	indexedHeap<uint64_t, std::greater<uint64_t>> heap(nodes);
+
+	dist[0] = 0;
+	handle[0] = heap.push(0);
+	node[handle[0]] = 0;
+	s.pushes++;
+	while (!heap.empty()) {
+		uint32_t v = node[heap.topHandle()];
+		heap.pop();
+		for (size_t e = g.first[v]; e < g.first[v + 1]; e++) {
+			uint32_t w = g.target[e];
+			uint64_t d = dist[v] + g.weight[e];
+			if (d >= dist[w]) continue;
+			//With non-negative weights a node that was already reached is still waiting in the heap
+			bool queued = dist[w] != UINT64_MAX;
+			dist[w] = d;
+			if (queued) heap.decrease_key(handle[w], d);
+			else {
+				handle[w] = heap.push(d);
+				node[handle[w]] = w;
+				s.pushes++;
+			}
+		}
+		if (heap.size() > s.peak) s.peak = heap.size();
+	}
+
+	s.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	for (uint64_t d : dist) s.checksum += d == UINT64_MAX ? 0 : d;
+	return s;
+}
+
+static stats lazy(const graph& g) {
+	stats s;
+	size_t nodes = g.first.size() - 1;
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<uint64_t> dist(nodes, UINT64_MAX);
+	minHeap<std::pair<uint64_t, uint32_t>> heap(g.target.size() + 1);
+
+	dist[0] = 0;
+	heap.push({ 0, 0 });
+	s.pushes++;
+	while (!heap.empty()) {
+		std::pair<uint64_t, uint32_t> top = heap.pop();
+		uint32_t v = top.second;
+		if (top.first > dist[v]) {
+			s.stale++;
+			continue;
+		}
+		for (size_t e = g.first[v]; e < g.first[v + 1]; e++) {
+			uint32_t w = g.target[e];
+			uint64_t d = dist[v] + g.weight[e];
+			if (d >= dist[w]) continue;
+			dist[w] = d;
+			heap.push({ d, w });
+			s.pushes++;
+		}
+		if (heap.size() > s.peak) s.peak = heap.size();
+	}
+
+	s.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	for (uint64_t d : dist) s.checksum += d == UINT64_MAX ? 0 : d;
+	return s;
+}
+
+static void print(const char* name, size_t nodes, size_t degree, const stats& s) {
+	std::printf("%-14s %10zu %6zu %10.1f %10zu %10zu %10zu   (%llu)\n", name, nodes, degree, s.ms, s.pushes, s.stale, s.peak, (unsigned long long)s.checksum);
+}
+
+int main() {
+	std::mt19937_64 rng(42);
+	std::printf("%-14s %10s %6s %10s %10s %10s %10s\n", "queue", "nodes", "degree", "time (ms)", "pushes", "stale pops", "peak size");
+	for (size_t nodes : { 10000, 100000, 1000000 }) {
+		for (size_t degree : { 4, 16 }) {
+			graph g = randomGraph(nodes, degree, rng);
+			print("lazy minHeap", nodes, degree, lazy(g));
+			print("indexedHeap", nodes, degree, indexed(g));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,232 @@
+/*
+Author: godraadam @ utcn 2019
+Description: k-way merge of sorted runs with a tournament (loser) tree
+			 a run is any pair of iterators [first, last) over items sorted by Compare, input iterators
+			 such as std::istream_iterator work too, every item is read exactly once
+			 the leaves of the tree are the heads of the runs, padded with empty runs to a power of two,
+			 every inner node keeps the item that lost the match played there and the winner moves on to the root
+			 after an item is taken only its own run plays again, on the path from its leaf to the root,
+			 one comparison per level and no sifting, a binary heap needs about twice as many,
+			 for small trivially copyable items a match selects its winner without a branch
+			 items that compare equal come out in the order of their runs, so the merge is stable
+			 drain() writes the merged items in batches, pop() one at a time
+			 the order is given by the Compare type, compare(a, b) returns true if a comes before b
+			 (std::less merges ascending runs, as std::merge)
+Operations: add()	-> O(1) (amortized time, the tree is rebuilt in O(k) on the next access)
+			pop()	-> O(log k)
+			peek()	-> O(1)
+			drain()	-> O(log k) per item
+			empty()	-> O(1)
+			runs()	-> O(1)
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <class Iterator, class Compare = std::less<typename std::iterator_traits<Iterator>::value_type>>
+
+class loserTree final {
+
+	//Type of the merged items
+	private: typedef typename std::iterator_traits<Iterator>::value_type T;
+
+	//Remaining part of a run
+	private: struct run {
+		Iterator next;
+		Iterator last;
+	};
+
+	//The current item of a run, kept inline so a match reads only the node it is played at
+	//The run index of an exhausted run has the top bit set
+	private: struct entry {
+		T item;
+		size_t run;
+	};
+
+	//Top bit of a run index
+	private: static const size_t exhausted = ~(SIZE_MAX >> 1);
+
+	//True for items cheap enough to copy on every match, such as numbers and pointers
+	private: static constexpr bool small = std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(size_t);
+
+	//Fields_______________________________________
+
+	//Number of runs, number of leaves of the tree and size of the arrays below, both powers of two
+	private: size_t k = 0;
+	private: size_t leaves = 0;
+	private: size_t _capacity = 0;
+
+	//The runs
+	private: run* _runs = nullptr;
+
+	//Current items of the runs, the leaves of the tree, valid while built is false
+	private: entry* heads = nullptr;
+
+	//tree[0] is the winner, the first item of the merge, tree[1..leaves-1] the losers of the inner nodes,
+	//the leaf of run i is node leaves + i and the parent of node n is n / 2, valid while built is true
+	private: entry* tree = nullptr;
+
+	//True while the current items are in the tree, false while they are in the leaves
+	private: bool built = false;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods______________________________________
+
+	//Constructor for an empty merge, runs are given with add()
+	public: loserTree() {}
+
+	//Constructor merging the count runs [firsts[i], lasts[i])
+	public: loserTree(const Iterator* firsts, const Iterator* lasts, size_t count) {
+		reserve(count);
+		for (size_t i = 0; i < count; i++) add(firsts[i], lasts[i]);
+	}
+
+	public: loserTree(const loserTree&) = delete;
+	public: loserTree& operator=(const loserTree&) = delete;
+
+	//Destructor
+	public: ~loserTree() {
+		delete[] _runs;
+		delete[] heads;
+		delete[] tree;
+	}
+
+	//Add the sorted run [first, last), also while a merge is under way, its items join from the next access on
+	public: void add(Iterator first, Iterator last) {
+		if (built) unwind();
+		if (k == _capacity) reserve(k + 1);
+		_runs[k] = run{ first, last };
+		heads[k].run = first == last ? k | exhausted : k;
+		if (first != last) heads[k].item = *first;
+		k++;
+	}
+
+	//Make room for count runs
+	public: void reserve(size_t count) {
+		if (count <= _capacity) return;
+		if (built) unwind();
+		size_t capacity = 8;
+		while (capacity < count) capacity *= 2;
+		run* r = new run[capacity];
+		entry* h = new entry[capacity];
+		for (size_t i = 0; i < k; i++) {
+			r[i] = std::move(_runs[i]);
+			h[i] = std::move(heads[i]);
+		}
+		delete[] _runs;
+		delete[] heads;
+		delete[] tree;
+		_runs = r;
+		heads = h;
+		tree = new entry[capacity];
+		_capacity = capacity;
+	}
+
+	//Remove and return the first item of the merge
+	public: T pop() {
+		if (empty()) throw std::length_error("Merge is empty!");
+		T ret = std::move(tree[0].item);
+		replay();
+		return ret;
+	}
+
+	//Return the first item of the merge without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Merge is empty!");
+		return tree[0].item;
+	}
+
+	//Write up to max of the next items of the merge to out, returns the number written
+	//Fewer than max are written only once every run is exhausted
+	public: template<class Output> size_t drain(Output out, size_t max) {
+		if (empty()) return 0;
+		size_t count = 0;
+		while (count < max && !(tree[0].run & exhausted)) {
+			*out = std::move(tree[0].item);
+			++out;
+			count++;
+			replay();
+		}
+		return count;
+	}
+
+	//Returns true only if every run is exhausted
+	public: bool empty() {
+		if (k == 0) return true;
+		if (!built) build();
+		return (tree[0].run & exhausted) != 0;
+	}
+
+	//Returns the number of runs, exhausted ones included
+	public: size_t runs() {
+		return k;
+	}
+
+	//Helpers______________________________________
+
+	//True if a comes before b, first tells whether the run of a is the lower one and wins on equal items
+	//Exhausted runs lose every match
+	private: bool beats(const entry& a, const entry& b, bool first) {
+		if ((a.run | b.run) & exhausted) return a.run < b.run;
+		const T* items[2] = { &a.item, &b.item };
+		return compare(*items[first], *items[!first]) != first;
+	}
+
+	//Take the next item of the winning run and play its matches on the way back to the root
+	//The runs under a left child are lower than the ones under its sibling, so the side a winner comes from
+	//settles equal items and every match costs a single comparison
+	private: void replay() {
+		entry winner;
+		winner.run = tree[0].run;
+		run& r = _runs[winner.run];
+		if (++r.next == r.last) winner.run |= exhausted;
+		else winner.item = *r.next;
+		for (size_t node = (winner.run & ~exhausted) + leaves; node > 1; node /= 2) {
+			entry& loser = tree[node / 2];
+			bool lost = beats(loser, winner, node & 1);
+			if constexpr (small) {
+				//Pick by index instead of branching, the outcome of a match is unpredictable
+				entry both[2] = { loser, winner };
+				loser = both[lost];
+				winner = both[!lost];
+			}
+			else if (lost) std::swap(loser, winner);
+		}
+		tree[0] = std::move(winner);
+	}
+
+	//Play every match bottom up, the leaves past the last run are empty runs
+	//Winners of the nodes are kept as indices into heads in a scratch array of 2 * leaves entries
+	private: void build() {
+		leaves = 1;
+		while (leaves < k) leaves *= 2;
+		for (size_t i = k; i < leaves; i++) heads[i].run = i | exhausted;
+		size_t* winners = new size_t[2 * leaves];
+		for (size_t i = 0; i < leaves; i++) winners[leaves + i] = i;
+		for (size_t node = leaves; node-- > 1;) {
+			size_t a = winners[2 * node], b = winners[2 * node + 1];
+			if (!beats(heads[a], heads[b], true)) std::swap(a, b);
+			winners[node] = a;
+			tree[node] = std::move(heads[b]);
+		}
+		tree[0] = std::move(heads[winners[1]]);
+		delete[] winners;
+		built = true;
+	}
+
+	//Move the current items back from the tree to the leaves, before runs are added to a merge under way
+	private: void unwind() {
+		for (size_t node = 0; node < leaves; node++) {
+			size_t i = tree[node].run & ~exhausted;
+			if (i < k) heads[i] = std::move(tree[node]);
+		}
+		built = false;
+	}
+};
@@ -0,0 +1,116 @@
+/*
+Author: godraadam @ utcn 2019
+Description: k-way merge of k sorted runs of random 64 bit keys, 16M keys in total, k = 8 to 4096
+			 minHeap: the heads of the runs as (key, run) pairs, pop() the smallest and push() the next of its run
+			 minHeap popAndPush(): the same with the pop and the push done in one sift
+			 loserTree: drain() in batches of 4096 keys
+			 the comparisons per merged key are counted in a separate pass
+Build: g++ -O2 -std=c++17 loser_tree_bench.cpp -o loser_tree_bench
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../binary_min_heap/binary_min_heap.cpp"
+#include "loser_tree.cpp"
+
+typedef std::vector<uint64_t>::const_iterator iterator;
+typedef std::pair<uint64_t, uint32_t> head;
+
+//Comparisons made by the counting comparators
+static size_t comparisons = 0;
+
+template <class Compare>
+struct counting {
+	Compare compare;
+	template <class T>
+	bool operator()(const T& a, const T& b) {
+		comparisons++;
+		return compare(a, b);
+	}
+};
+
+//Merge with a heap of run heads, pop() and push() or popAndPush(), returns the sum of the output as a checksum
+template <class Heap>
+static uint64_t heapMerge(const std::vector<std::vector<uint64_t>>& runs, std::vector<uint64_t>& out, bool combined) {
+	size_t k = runs.size();
+	Heap heap(k);
+	std::vector<iterator> next(k);
+	for (uint32_t i = 0; i < k; i++) {
+		next[i] = runs[i].begin();
+		if (next[i] != runs[i].end()) heap.push({ *next[i]++, i });
+	}
+	size_t n = 0;
+	while (!heap.empty()) {
+		if (combined) {
+			head top = heap.peek();
+			out[n++] = top.first;
+			if (next[top.second] != runs[top.second].end()) heap.popAndPush({ *next[top.second]++, top.second });
+			else heap.pop();
+		}
+		else {
+			head top = heap.pop();
+			out[n++] = top.first;
+			if (next[top.second] != runs[top.second].end()) heap.push({ *next[top.second]++, top.second });
+		}
+	}
+	uint64_t sum = 0;
+	for (size_t i = 0; i < n; i++) sum += out[i];
+	return sum;
+}
+
+template <class Tree>
+static uint64_t treeMerge(const std::vector<std::vector<uint64_t>>& runs, std::vector<uint64_t>& out) {
+	Tree tree;
+	tree.reserve(runs.size());
+	for (const std::vector<uint64_t>& r : runs) tree.add(r.begin(), r.end());
+	size_t n = 0, count;
+	while ((count = tree.drain(out.data() + n, 4096)) > 0) n += count;
+	uint64_t sum = 0;
+	for (size_t i = 0; i < n; i++) sum += out[i];
+	return sum;
+}
+
+template <class F>
+static double rate(size_t n, F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return n / seconds / 1e6;
+}
+
+int main() {
+	const size_t n = (size_t)1 << 24;
+	std::mt19937_64 rng(42);
+	std::vector<uint64_t> out(n);
+
+	std::printf("%zu keys, millions of keys per second and comparisons per key\n", n);
+	std::printf("%6s %14s %14s %14s %12s %12s\n", "k", "minHeap", "popAndPush", "loserTree", "heap cmp", "tree cmp");
+	for (size_t k = 8; k <= 4096; k *= 2) {
+		std::vector<std::vector<uint64_t>> runs(k);
+		for (size_t i = 0; i < n; i++) runs[rng() % k].push_back(rng());
+		for (std::vector<uint64_t>& r : runs) std::sort(r.begin(), r.end());
+
+		uint64_t expected = 0, got = 0, combined = 0;
+		double heap = rate(n, [&] { expected = heapMerge<minHeap<head>>(runs, out, false); });
+		bool sorted = std::is_sorted(out.begin(), out.end());
+		double single = rate(n, [&] { combined = heapMerge<minHeap<head>>(runs, out, true); });
+		double tree = rate(n, [&] { got = treeMerge<loserTree<iterator>>(runs, out); });
+		bool ok = sorted && std::is_sorted(out.begin(), out.end()) && got == expected && combined == expected;
+
+		comparisons = 0;
+		heapMerge<binaryHeap<head, counting<std::greater<head>>>>(runs, out, false);
+		double heap_cmp = (double)comparisons / n;
+		comparisons = 0;
+		treeMerge<loserTree<iterator, counting<std::less<uint64_t>>>>(runs, out);
+		double tree_cmp = (double)comparisons / n;
+
+		std::printf("%6zu %14.1f %14.1f %14.1f %12.2f %12.2f%s\n", k, heap, single, tree, heap_cmp, tree_cmp, ok ? "" : "   mismatch!");
+	}
+	return 0;
+}
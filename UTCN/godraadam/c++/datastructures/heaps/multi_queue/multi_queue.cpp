@@ -0,0 +1,183 @@
+/*
+Author: godraadam @ utcn 2019
+Description: relaxed concurrent priority queue (MultiQueue) built from c * P binary heaps, each guarded by its own lock
+			 push() puts the item into a random heap, pop() samples two random heaps and takes the better of their tops
+			 so threads rarely meet on the same lock, in exchange pop() returns one of the highest priority items
+			 but not necessarily the highest, the expected rank error grows with the number of heaps
+			 locks are only ever tried, a busy heap is skipped for another random one,
+			 after enough failed tries an operation waits for the lock of one heap
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (std::less, as in maxHeap, pops the largest items first)
+Operations: push()	-> O(log(n / cP)) (expected, with c * P heaps)
+			try_pop() -> O(log(n / cP)) (expected)
+			pop()	-> O(log(n / cP)) (expected)
+			size()	-> O(c * P) (approximate while other threads are modifying the queue)
+			empty()	-> O(c * P) (approximate while other threads are modifying the queue)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "../binary_max_heap/binary_max_heap.cpp"
+
+template <class T, class Compare = std::less<T>>
+
+class multiQueue final {
+
+	//Number of lock attempts on random heaps before an operation waits for a lock
+	private: static const size_t tries = 8;
+
+	//A heap and its lock, padded so neighbouring heaps do not share cache lines
+	private: struct alignas(64) lane {
+		std::mutex lock;
+		binaryHeap<T, Compare> heap;
+
+		//Number of items, read without the lock to skip empty heaps
+		std::atomic<size_t> size{ 0 };
+
+		lane(size_t max_size) : heap(max_size) {}
+	};
+
+	//Fields_______________________________________
+
+	//Number of heaps
+	private: size_t count;
+
+	private: lane* lanes;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods______________________________________
+
+	//Constructor for the given number of threads, c heaps per thread, each holding at most max_size items
+	public: multiQueue(size_t threads = std::thread::hardware_concurrency(), size_t c = 2, size_t max_size = UINT16_MAX) {
+		count = (threads == 0 ? 1 : threads) * (c == 0 ? 1 : c);
+		lanes = static_cast<lane*>(::operator new(count * sizeof(lane), std::align_val_t(alignof(lane))));
+		for (size_t i = 0; i < count; i++) new (lanes + i) lane(max_size);
+	}
+
+	public: multiQueue(const multiQueue&) = delete;
+	public: multiQueue& operator=(const multiQueue&) = delete;
+
+	//Destructor, must not run concurrently with any other operation on the queue
+	public: ~multiQueue() {
+		for (size_t i = 0; i < count; i++) lanes[i].~lane();
+		::operator delete(lanes, std::align_val_t(alignof(lane)));
+	}
+
+	//Insert item into a random heap, throws only if every heap is full
+	public: void push(T item) {
+		for (size_t attempt = 0; attempt < tries; attempt++) {
+			lane& l = lanes[random() % count];
+			if (!l.lock.try_lock()) continue;
+			bool pushed = insert(l, item);
+			l.lock.unlock();
+			if (pushed) return;
+		}
+
+		//Every try met a busy or full heap, go through all of them waiting for each lock
+		size_t start = (size_t)(random() % count);
+		for (size_t i = 0; i < count; i++) {
+			lane& l = lanes[(start + i) % count];
+			std::lock_guard<std::mutex> guard(l.lock);
+			if (insert(l, item)) return;
+		}
+		throw std::length_error("Queue is full!");
+	}
+
+	//Remove one of the highest priority items into item, the better top of two random heaps
+	//Returns false only if every heap was found empty
+	public: bool try_pop(T& item) {
+		return take([&item](T&& top) { item = std::move(top); });
+	}
+
+	//Remove and return one of the highest priority items
+	//The item is built straight from the popped one, so T needs no default constructor
+	public: T pop() {
+		std::optional<T> item;
+		if (!take([&item](T&& top) { item.emplace(std::move(top)); })) throw std::length_error("Queue is empty!");
+		return std::move(*item);
+	}
+
+	//Returns current number of items in the queue
+	public: size_t size() {
+		size_t total = 0;
+		for (size_t i = 0; i < count; i++) total += lanes[i].size.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	//Returns true only if the queue is empty
+	public: bool empty() {
+		return size() == 0;
+	}
+
+	//Returns the number of heaps
+	public: size_t heaps() {
+		return count;
+	}
+
+	//Helpers______________________________________
+
+	//Remove one of the highest priority items and hand it to out, the better top of two random heaps
+	//Returns false only if every heap was found empty
+	private: template<class Out> bool take(Out out) {
+		for (size_t attempt = 0; attempt < tries; attempt++) {
+			lane* a = &lanes[random() % count];
+			lane* b = &lanes[random() % count];
+			if (a->size.load(std::memory_order_relaxed) == 0) std::swap(a, b);
+			if (a->size.load(std::memory_order_relaxed) == 0) continue;
+			if (!a->lock.try_lock()) continue;
+
+			//Take the second heap into account only if it is free and has items
+			bool both = b != a && b->size.load(std::memory_order_relaxed) != 0 && b->lock.try_lock();
+			if (both && (a->heap.empty() || (!b->heap.empty() && compare(a->heap.peek(), b->heap.peek())))) std::swap(a, b);
+			bool popped = remove(*a, out);
+			if (both) b->lock.unlock();
+			a->lock.unlock();
+			if (popped) return true;
+		}
+
+		//Few items or a lot of contention, go through all heaps waiting for each lock
+		size_t start = (size_t)(random() % count);
+		for (size_t i = 0; i < count; i++) {
+			lane& l = lanes[(start + i) % count];
+			if (l.size.load(std::memory_order_relaxed) == 0) continue;
+			std::lock_guard<std::mutex> guard(l.lock);
+			if (remove(l, out)) return true;
+		}
+		return false;
+	}
+
+	//Push item into the heap of a locked lane, returns false if it is full
+	private: bool insert(lane& l, T& item) {
+		if (l.heap.full()) return false;
+		l.heap.push(std::move(item));
+		l.size.store(l.heap.size(), std::memory_order_relaxed);
+		return true;
+	}
+
+	//Pop the top of the heap of a locked lane and hand it to out, returns false if it is empty
+	private: template<class Out> bool remove(lane& l, Out& out) {
+		if (l.heap.empty()) return false;
+		out(l.heap.pop());
+		l.size.store(l.heap.size(), std::memory_order_relaxed);
+		return true;
+	}
+
+	//Per-thread xorshift generator for picking heaps
+	private: static uint64_t random() {
+		static thread_local uint64_t state = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
@@ -0,0 +1,109 @@
+/*
+Author: godraadam @ utcn 2019
+Description: benchmark of the MultiQueue against a single maxHeap guarded by one mutex
+			 throughput: every thread alternates push() of a random key and pop() on a prefilled queue,
+			 from 1 thread up to twice the hardware threads
+			 rank error: keys 0..n-1 pushed in random order and popped one by one from a single thread,
+			 the rank of a popped key is the number of larger keys still in the queue (0 for an exact queue)
+Build: g++ -O2 -std=c++17 -pthread multi_queue_bench.cpp -o multi_queue_bench
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "multi_queue.cpp"
+
+//The current scheduler queue: one heap, one lock
+struct lockedHeap {
+	std::mutex lock;
+	maxHeap<uint64_t> heap;
+
+	lockedHeap(size_t max_size) : heap(max_size) {}
+
+	void push(uint64_t item) {
+		std::lock_guard<std::mutex> guard(lock);
+		heap.push(item);
+	}
+
+	bool try_pop(uint64_t& item) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (heap.empty()) return false;
+		item = heap.pop();
+		return true;
+	}
+};
+
+//Prefill the queue, then every thread runs operations push/pop pairs, returns millions of operations per second
+template <class Q>
+static double throughput(Q& queue, size_t threads, size_t prefill, size_t operations) {
+	std::mt19937_64 rng(1);
+	for (size_t i = 0; i < prefill; i++) queue.push(rng() % 1000000007);
+
+	std::vector<std::thread> workers;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&queue, t, operations] {
+			std::mt19937_64 local(t + 2);
+			uint64_t item;
+			for (size_t i = 0; i < operations / 2; i++) {
+				queue.push(local() % 1000000007);
+				queue.try_pop(item);
+			}
+		});
+	}
+	for (std::thread& w : workers) w.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return threads * operations / seconds / 1e6;
+}
+
+//Mean and largest rank error of popping n keys from a MultiQueue made for the given number of threads
+static void rankError(size_t threads, size_t n) {
+	std::vector<uint64_t> keys(n);
+	for (size_t i = 0; i < n; i++) keys[i] = i;
+	std::shuffle(keys.begin(), keys.end(), std::mt19937_64(3));
+
+	multiQueue<uint64_t> queue(threads, 2, n);
+	for (uint64_t key : keys) queue.push(key);
+
+	//Fenwick tree over the keys still in the queue
+	std::vector<size_t> tree(n + 1, 0);
+	auto add = [&](size_t i, long delta) { for (i++; i <= n; i += i & (0 - i)) tree[i] += delta; };
+	auto below = [&](size_t i) { size_t sum = 0; for (; i > 0; i -= i & (0 - i)) sum += tree[i]; return sum; };
+	for (size_t i = 0; i < n; i++) add(i, 1);
+
+	double total = 0;
+	size_t worst = 0, left = n;
+	for (size_t i = 0; i < n; i++) {
+		uint64_t key = queue.pop();
+		size_t rank = left - below((size_t)key + 1);
+		total += rank;
+		if (rank > worst) worst = rank;
+		add((size_t)key, -1);
+		left--;
+	}
+	std::printf("%8zu %8zu %14.2f %14zu\n", threads, queue.heaps(), total / n, worst);
+}
+
+int main() {
+	const size_t prefill = 1000000;
+	const size_t operations = 2000000;
+	size_t max_threads = std::thread::hardware_concurrency();
+	if (max_threads == 0) max_threads = 1;
+
+	std::printf("throughput, millions of operations per second\n%8s %14s %14s\n", "threads", "locked heap", "multiQueue");
+	for (size_t threads = 1; threads <= 2 * max_threads; threads *= 2) {
+		lockedHeap locked(prefill + threads * operations);
+		multiQueue<uint64_t> multi(threads, 2, prefill + threads * operations);
+		double a = throughput(locked, threads, prefill, operations);
+		double b = throughput(multi, threads, prefill, operations);
+		std::printf("%8zu %14.2f %14.2f\n", threads, a, b);
+	}
+
+	std::printf("\nrank error of 1M keys, c = 2\n%8s %8s %14s %14s\n", "threads", "heaps", "mean rank", "max rank");
+	for (size_t threads : { 1, 2, 4, 8, 16, 32 }) rankError(threads, 1000000);
+	return 0;
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: generic pairing heap, a heap ordered multiway tree stored as child / sibling linked nodes
+			 two heaps are melded by making the lower priority root the first child of the other
+			 pop() merges the children of the root in two passes, pairing them left to right, then melding the pairs right to left
+			 push() returns a handle to the node of the item, valid until the item leaves the heap,
+			 through which its key can be updated or the item erased
+			 nodes come from a slab arena (allocators/slab), heaps sharing one arena can be melded in O(1) and
+			 their handles stay valid, melding heaps with different arenas copies the items over in O(m)
+			 an arena is not thread safe, heaps sharing it must be used by one thread at a time
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (std::less gives a max-heap and std::greater a min-heap)
+			 decrease_key() and increase_key() compare the key values themselves with operator<, whatever Compare is,
+			 and update() cuts or reinserts the item as Compare requires (in a min-heap decrease_key() takes the
+			 cheap cut and meld path)
+Operations: push()	-> O(1)
+			emplace() -> O(1)
+			meld()	-> O(1)
+			peek()	-> O(1)
+			pop()	-> O(log n) (amortized time)
+			decrease_key() -> O(log n) (amortized time)
+			increase_key() -> O(log n) (amortized time)
+			update() -> O(log n) (amortized time)
+			erase()	-> O(log n) (amortized time)
+			size()	-> O(1)
+			empty()	-> O(1)
+*/
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "../../allocators/slab/slab.cpp"
+
+template <class T, class Compare = std::less<T>>
+
+class pairingHeap final {
+
+	//Helper class for linking data
+	//prev is the parent for the first child and the previous sibling for every other child
+	private: class node {
+		public: T item;
+		node* child = nullptr;
+		node* next = nullptr;
+		node* prev = nullptr;
+
+		public: template<class... Args> node(Args&&... args) : item(std::forward<Args>(args)...) {}
+	};
+
+	//Handle of an item inside the heap
+	public: typedef node* handle;
+
+	//Slab allocator for nodes, hands out nodes from contiguous blocks
+	public: typedef slab<node> arena;
+
+	//Fields_____________________________________
+
+	//Root of the tree, the item with the highest priority
+	private: node* root = nullptr;
+
+	//Current number of items in the heap
+	private: size_t _size = 0;
+
+	//Memory for the nodes, possibly shared with other heaps
+	private: std::shared_ptr<arena> pool;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//Default constructor, the heap gets an arena of its own
+	public: pairingHeap() : pool(std::make_shared<arena>()) {}
+
+	//Constructor with an arena shared with other heaps, allowing them to be melded in O(1)
+	public: pairingHeap(std::shared_ptr<arena> pool) : pool(std::move(pool)) {
+		if (this->pool == nullptr) throw std::invalid_argument("Invalid arena!");
+	}
+
+	//Nodes are owned by the heap, copying it would free them twice
+	public: pairingHeap(const pairingHeap&) = delete;
+	public: pairingHeap& operator=(const pairingHeap&) = delete;
+
+	//Destructor, destroys the remaining items, the arena is released with its last heap
+	public: ~pairingHeap() {
+		drain([](T&&) {});
+	}
+
+	//Returns the arena of this heap, pass it to the constructor of heaps that will be melded into this one
+	public: std::shared_ptr<arena> memory() {
+		return pool;
+	}
+
+	//Insert new item to heap, returns its handle
+	public: handle push(T item) {
+		return emplace(std::move(item));
+	}
+
+	//Construct new item from the given arguments and insert it, returns its handle
+	public: template<class... Args> handle emplace(Args&&... args) {
+		node* p = pool->allocate();
+		try {
+			new (p) node(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			//Constructing the item threw, the slot goes back to the freelist
+			pool->deallocate(p);
+			throw;
+		}
+		root = merge(root, p);
+		_size++;
+		return p;
+	}
+
+	//Move all items of other into this heap, leaving other empty
+	//Handles into other stay valid only if both heaps share an arena
+	public: void meld(pairingHeap& other) {
+		if (&other == this || other.root == nullptr) return;
+		if (other.pool == pool) {
+			root = merge(root, other.root);
+			_size += other._size;
+			other.root = nullptr;
+			other._size = 0;
+		}
+		else other.drain([this](T&& item) { emplace(std::move(item)); });
+	}
+
+	//Remove and return root of the heap while preserving heap property
+	public: T pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		node* p = root;
+		root = combine(p->child);
+		T ret = std::move(p->item);
+		pool->release(p);
+		_size--;
+		return ret;
+	}
+
+	//Return root of the heap without removing it
+	public: T peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		return root->item;
+	}
+
+	//Return the item with the given handle
+	public: T get(handle p) {
+		return p->item;
+	}
+
+	//Lower the key of the item with the given handle, the new key must not be larger than the current one
+	public: void decrease_key(handle p, T item) {
+		if (std::less<T>()(p->item, item)) throw std::invalid_argument("New key is larger than the current one!");
+		update(p, std::move(item));
+	}
+
+	//Raise the key of the item with the given handle, the new key must not be smaller than the current one
+	public: void increase_key(handle p, T item) {
+		if (std::less<T>()(item, p->item)) throw std::invalid_argument("New key is smaller than the current one!");
+		update(p, std::move(item));
+	}
+
+	//Replace the key of the item with the given handle
+	//If the item gains priority its subtree is cut and melded with the root,
+	//otherwise its children are merged back into the heap and the node is reinserted alone
+	public: void update(handle p, T item) {
+		bool up = compare(p->item, item);
+		p->item = std::move(item);
+		if (up) {
+			if (p != root) {
+				cut(p);
+				root = merge(root, p);
+			}
+			return;
+		}
+		node* children = combine(p->child);
+		p->child = nullptr;
+		if (p == root) root = nullptr;
+		else cut(p);
+		root = merge(merge(root, children), p);
+	}
+
+	//Remove and return the item with the given handle
+	public: T erase(handle p) {
+		if (p == root) return pop();
+		cut(p);
+		root = merge(root, combine(p->child));
+		T ret = std::move(p->item);
+		pool->release(p);
+		_size--;
+		return ret;
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Helpers______________________________________________________
+
+	//Meld two trees, the root with lower priority becomes the first child of the other
+	private: node* merge(node* a, node* b) {
+		if (a == nullptr) return b;
+		if (b == nullptr) return a;
+		if (compare(a->item, b->item)) std::swap(a, b);
+		b->prev = a;
+		b->next = a->child;
+		if (a->child != nullptr) a->child->prev = b;
+		a->child = b;
+		a->next = nullptr;
+		a->prev = nullptr;
+		return a;
+	}
+
+	//Detach the subtree rooted at p from its parent and siblings
+	private: void cut(node* p) {
+		if (p->prev->child == p) p->prev->child = p->next;
+		else p->prev->next = p->next;
+		if (p->next != nullptr) p->next->prev = p->prev;
+		p->next = nullptr;
+		p->prev = nullptr;
+	}
+
+	//Merge a list of siblings into one tree, pairing left to right then melding the pairs right to left
+	private: node* combine(node* first) {
+		if (first == nullptr) return nullptr;
+
+		//The pairs are chained through next in reverse order
+		node* pairs = nullptr;
+		while (first != nullptr) {
+			node* a = first;
+			node* b = a->next;
+			first = b != nullptr ? b->next : nullptr;
+			a->next = nullptr;
+			if (b != nullptr) b->next = nullptr;
+			node* pair = merge(a, b);
+			pair->next = pairs;
+			pairs = pair;
+		}
+
+		node* tree = pairs;
+		pairs = pairs->next;
+		tree->next = nullptr;
+		while (pairs != nullptr) {
+			node* p = pairs;
+			pairs = p->next;
+			tree = merge(tree, p);
+		}
+		return tree;
+	}
+
+	//Hand every item to f and release all nodes, leaving the heap empty
+	private: template<class F> void drain(F f) {
+		//Nodes still to visit are chained through next, children are spliced in front
+		node* work = root;
+		while (work != nullptr) {
+			node* p = work;
+			work = p->next;
+			if (p->child != nullptr) {
+				node* last = p->child;
+				while (last->next != nullptr) last = last->next;
+				last->next = work;
+				work = p->child;
+			}
+			f(std::move(p->item));
+			pool->release(p);
+		}
+		root = nullptr;
+		_size = 0;
+	}
+};
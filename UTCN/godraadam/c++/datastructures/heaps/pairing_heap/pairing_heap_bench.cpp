@@ -0,0 +1,73 @@
+/*
+Author: godraadam @ utcn 2019
+Description: merging k shard queues of a total of n items into one, then popping everything from it
+			 maxHeap: drain every shard with pop() and push() the items into the target heap
+			 pairingHeap, shared arena: meld() every shard in O(1)
+			 pairingHeap, own arenas: meld() falls back to copying the items of every shard
+Build: g++ -O2 -std=c++17 pairing_heap_bench.cpp -o pairing_heap_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../binary_max_heap/binary_max_heap.cpp"
+#include "pairing_heap.cpp"
+
+static double since(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void print(const char* name, size_t shards, size_t n, double merge, double drain, long sink) {
+	std::printf("%-26s %8zu %10zu %12.3f %12.1f   (%ld)\n", name, shards, n, merge, drain, sink);
+}
+
+static void binary(const std::vector<long>& keys, size_t shards) {
+	std::vector<std::unique_ptr<maxHeap<long>>> shard;
+	for (size_t i = 0; i < shards; i++) shard.emplace_back(new maxHeap<long>(keys.size()));
+	for (size_t i = 0; i < keys.size(); i++) shard[i % shards]->push(keys[i]);
+
+	auto start = std::chrono::steady_clock::now();
+	maxHeap<long>& target = *shard[0];
+	for (size_t i = 1; i < shards; i++)
+		while (!shard[i]->empty()) target.push(shard[i]->pop());
+	double merge = since(start);
+
+	long sink = 0;
+	start = std::chrono::steady_clock::now();
+	while (!target.empty()) sink += target.pop();
+	print("maxHeap drain and push", shards, keys.size(), merge, since(start), sink);
+}
+
+static void pairing(const std::vector<long>& keys, size_t shards, bool shared) {
+	std::shared_ptr<pairingHeap<long>::arena> pool = std::make_shared<pairingHeap<long>::arena>();
+	std::vector<std::unique_ptr<pairingHeap<long>>> shard;
+	for (size_t i = 0; i < shards; i++) shard.emplace_back(shared ? new pairingHeap<long>(pool) : new pairingHeap<long>());
+	for (size_t i = 0; i < keys.size(); i++) shard[i % shards]->push(keys[i]);
+
+	auto start = std::chrono::steady_clock::now();
+	pairingHeap<long>& target = *shard[0];
+	for (size_t i = 1; i < shards; i++) target.meld(*shard[i]);
+	double merge = since(start);
+
+	long sink = 0;
+	start = std::chrono::steady_clock::now();
+	while (!target.empty()) sink += target.pop();
+	print(shared ? "pairingHeap shared arena" : "pairingHeap own arenas", shards, keys.size(), merge, since(start), sink);
+}
+
+int main() {
+	std::mt19937_64 rng(42);
+	std::printf("%-26s %8s %10s %12s %12s\n", "queue", "shards", "items", "merge (ms)", "drain (ms)");
+	for (size_t n : { 100000, 1000000 }) {
+		std::vector<long> keys(n);
+		for (long& key : keys) key = (long)(rng() % 1000000007);
+		for (size_t shards : { 4, 64, 1024 }) {
+			binary(keys, shards);
+			pairing(keys, shards, true);
+			pairing(keys, shards, false);
+		}
+	}
+	return 0;
+}
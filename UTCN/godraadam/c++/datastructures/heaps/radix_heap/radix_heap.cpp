@@ -0,0 +1,187 @@
+#pragma once
+
+/*
+Author: godraadam @ utcn 2019
+Description: monotone radix heap for unsigned integer keys with a payload, smallest key on top
+			 keys pushed must not be smaller than the last key popped, as in dijkstra or an event simulation
+			 items are kept in buckets by the highest bit in which their key differs from the last popped key,
+			 bucket 0 holds keys equal to it, bucket b keys differing first in bit b - 1
+			 when bucket 0 runs out, the first non-empty bucket is emptied into the lower ones around its minimum,
+			 every item only ever moves to a lower bucket so it is moved at most once per key bit
+			 no key comparisons between items are needed besides finding the minimum of a bucket
+			 only pop() moves the last popped key, peek() finds the minimum of the first non-empty bucket
+			 without moving any items and remembers it, so the next pop() does not search again
+Operations: push()	-> O(1)
+			emplace() -> O(1)
+			pop()	-> O(log C) (amortized time, C is the largest key difference)
+			peek()	-> O(1) (amortized time, the search is paid for by the next pop())
+			size()	-> O(1)
+			empty()	-> O(1)
+*/
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <class K, class V>
+
+class radixHeap final {
+
+	static_assert(std::is_unsigned<K>::value, "Keys of a radix heap must be unsigned integers!");
+
+	public: typedef std::pair<K, V> item;
+
+	//Number of buckets, one for keys equal to the last popped key and one per key bit
+	private: static const size_t bucket_count = std::numeric_limits<K>::digits + 1;
+
+	//Growable array of items with the same highest differing bit
+	private: class bucket final {
+		public: item* items = nullptr;
+		public: size_t size = 0;
+		public: size_t capacity = 0;
+
+		public: ~bucket() {
+			clear();
+			std::allocator<item>().deallocate(items, capacity);
+		}
+
+		public: template<class... Args> void emplace(Args&&... args) {
+			if (size == capacity) grow();
+			new (items + size) item(std::forward<Args>(args)...);
+			size++;
+		}
+
+		//Destroy all items, keeping the memory for reuse
+		public: void clear() {
+			for (size_t i = 0; i < size; i++) items[i].~item();
+			size = 0;
+		}
+
+		//Double the capacity, moving the items over
+		private: void grow() {
+			size_t _capacity = capacity == 0 ? 8 : capacity * 2;
+			item* _items = std::allocator<item>().allocate(_capacity);
+			for (size_t i = 0; i < size; i++) {
+				new (_items + i) item(std::move(items[i]));
+				items[i].~item();
+			}
+			std::allocator<item>().deallocate(items, capacity);
+			items = _items;
+			capacity = _capacity;
+		}
+	};
+
+	//Fields_____________________________________
+
+	//Current number of items in the heap
+	private: size_t _size = 0;
+
+	//Last popped key, the lower bound of every key in the heap
+	private: K last = 0;
+
+	//Buckets by highest bit differing from last
+	private: bucket buckets[bucket_count];
+
+	//Position of the smallest item found by peek() while bucket 0 is empty, valid while peeked is true
+	private: bool peeked = false;
+	private: size_t peek_bucket = 0;
+	private: size_t peek_index = 0;
+
+	//Methods_____________________________________
+
+	//Default constructor
+	public: radixHeap() {}
+
+	public: radixHeap(const radixHeap&) = delete;
+	public: radixHeap& operator=(const radixHeap&) = delete;
+
+	//Insert new item, key must not be smaller than the last popped one
+	public: void push(K key, V value) {
+		emplace(key, std::move(value));
+	}
+
+	//Construct new payload from the given arguments and insert it with key
+	public: template<class... Args> void emplace(K key, Args&&... args) {
+		if (key < last) throw std::invalid_argument("Key is smaller than the last popped one!");
+		size_t b = index(key);
+		buckets[b].emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+		_size++;
+		//Items are only appended, so the remembered minimum moves only if the new key is smaller,
+		//bucket 0 is served before it anyway
+		if (peeked && b != 0 && key < buckets[peek_bucket].items[peek_index].first) {
+			peek_bucket = b;
+			peek_index = buckets[b].size - 1;
+		}
+	}
+
+	//Remove and return an item with the smallest key
+	public: item pop() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		if (buckets[0].size == 0) refill();
+		item ret = std::move(buckets[0].items[buckets[0].size - 1]);
+		buckets[0].items[--buckets[0].size].~item();
+		_size--;
+		return ret;
+	}
+
+	//Return an item with the smallest key without removing it
+	//Keys not smaller than the last popped one can still be pushed afterwards
+	public: item peek() {
+		if (empty()) throw std::length_error("Heap is empty!");
+		if (buckets[0].size != 0) return buckets[0].items[buckets[0].size - 1];
+		if (!peeked) find();
+		return buckets[peek_bucket].items[peek_index];
+	}
+
+	//Returns true if heap contains no items otherwise false
+	public: bool empty() {
+		return _size == 0;
+	}
+
+	//Returns the current number of items inside the heap
+	public: size_t size() {
+		return _size;
+	}
+
+	//Helpers______________________________________________________
+
+	//Return the bucket of key, the position of the highest bit in which it differs from last
+	private: size_t index(K key) {
+		K diff = key ^ last;
+		if (diff == 0) return 0;
+		if (sizeof(K) <= sizeof(unsigned int)) return std::numeric_limits<unsigned int>::digits - __builtin_clz((unsigned int)diff);
+		return std::numeric_limits<unsigned long long>::digits - __builtin_clzll((unsigned long long)diff);
+	}
+
+	//Find the smallest item of the first non-empty bucket, which is the smallest one in the heap
+	private: void find() {
+		size_t b = 1;
+		while (buckets[b].size == 0) b++;
+
+		bucket& from = buckets[b];
+		size_t min = 0;
+		for (size_t i = 1; i < from.size; i++)
+			if (from.items[i].first < from.items[min].first) min = i;
+		peek_bucket = b;
+		peek_index = min;
+		peeked = true;
+	}
+
+	//Empty the first non-empty bucket into the lower ones, its minimum becomes last
+	//Called by pop() only, moving last is what makes smaller keys invalid
+	private: void refill() {
+		if (!peeked) find();
+		peeked = false;
+
+		bucket& from = buckets[peek_bucket];
+		last = from.items[peek_index].first;
+
+		for (size_t i = 0; i < from.size; i++) buckets[index(from.items[i].first)].emplace(std::move(from.items[i]));
+		from.clear();
+	}
+};
@@ -0,0 +1,165 @@
+/*
+Author: godraadam @ utcn 2019
+Description: benchmark of the radix heap against minHeap on two monotone workloads
+			 dijkstra on random sparse graphs, both queues with lazy deletion of stale entries
+			 event queue (hold model): n pending events, each popped event schedules one at now + random delay
+			 a self check runs first: peek() must not reject keys between the last popped key and the minimum,
+			 then random pushes, peeks and pops are compared against minHeap
+Build: g++ -O2 -std=c++17 radix_heap_bench.cpp -o radix_heap_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../binary_min_heap/binary_min_heap.cpp"
+#include "radix_heap.cpp"
+
+//Graph in compressed adjacency form, edges of node v are in [first[v], first[v + 1])
+struct graph {
+	std::vector<size_t> first;
+	std::vector<uint32_t> target;
+	std::vector<uint32_t> weight;
+};
+
+static graph randomGraph(size_t nodes, size_t degree, std::mt19937_64& rng) {
+	graph g;
+	g.first.resize(nodes + 1);
+	for (size_t v = 0; v <= nodes; v++) g.first[v] = v * degree;
+	for (size_t e = 0; e < nodes * degree; e++) {
+		g.target.push_back((uint32_t)(rng() % nodes));
+		g.weight.push_back((uint32_t)(rng() % 1000 + 1));
+	}
+	return g;
+}
+
+//Minimal interface over both queues: push(key, node), pop() -> (key, node)
+struct binaryQueue {
+	minHeap<std::pair<uint64_t, uint32_t>> heap;
+	binaryQueue(size_t max_size) : heap(max_size) {}
+	void push(uint64_t key, uint32_t value) { heap.push({ key, value }); }
+	std::pair<uint64_t, uint32_t> pop() { return heap.pop(); }
+	bool empty() { return heap.empty(); }
+};
+
+struct radixQueue {
+	radixHeap<uint64_t, uint32_t> heap;
+	radixQueue(size_t) {}
+	void push(uint64_t key, uint32_t value) { heap.push(key, value); }
+	std::pair<uint64_t, uint32_t> pop() { return heap.pop(); }
+	bool empty() { return heap.empty(); }
+};
+
+template <class Q>
+static double dijkstra(const graph& g, uint64_t& checksum) {
+	size_t nodes = g.first.size() - 1;
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<uint64_t> dist(nodes, UINT64_MAX);
+	Q queue(g.target.size() + 1);
+	dist[0] = 0;
+	queue.push(0, 0);
+	while (!queue.empty()) {
+		std::pair<uint64_t, uint32_t> top = queue.pop();
+		uint32_t v = top.second;
+		if (top.first > dist[v]) continue;
+		for (size_t e = g.first[v]; e < g.first[v + 1]; e++) {
+			uint32_t w = g.target[e];
+			uint64_t d = dist[v] + g.weight[e];
+			if (d >= dist[w]) continue;
+			dist[w] = d;
+			queue.push(d, w);
+		}
+	}
+
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	for (uint64_t d : dist) checksum += d == UINT64_MAX ? 0 : d;
+	return ms;
+}
+
+//Keep pending events in the queue, every popped event schedules the next one of its source
+template <class Q>
+static double events(size_t pending, size_t steps, uint64_t max_delay, uint64_t& checksum) {
+	std::mt19937_64 rng(7);
+	auto start = std::chrono::steady_clock::now();
+
+	Q queue(pending);
+	for (size_t i = 0; i < pending; i++) queue.push(rng() % max_delay, (uint32_t)i);
+	for (size_t i = 0; i < steps; i++) {
+		std::pair<uint64_t, uint32_t> event = queue.pop();
+		checksum += event.first ^ event.second;
+		queue.push(event.first + 1 + rng() % max_delay, event.second);
+	}
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Returns true if the radix heap agrees with minHeap, also after peek() calls between pushes
+static bool selfCheck() {
+	radixHeap<uint64_t, uint32_t> radix;
+	radix.push(5, 0);
+	radix.push(10, 1);
+	if (radix.pop().first != 5 || radix.peek().first != 10) return false;
+	try {
+		radix.push(7, 2);
+	}
+	catch (std::invalid_argument&) {
+		return false;
+	}
+	if (radix.pop().first != 7 || radix.pop().first != 10 || !radix.empty()) return false;
+
+	std::mt19937_64 rng(3);
+	minHeap<uint64_t> reference(100000);
+	uint64_t floor = 0;
+	for (size_t i = 0; i < 100000; i++) {
+		size_t op = rng() % 3;
+		if (op == 0 || reference.empty()) {
+			uint64_t key = floor + rng() % 1000;
+			radix.push(key, (uint32_t)i);
+			reference.push(key);
+		}
+		else if (op == 1) {
+			if (radix.peek().first != reference.peek()) return false;
+		}
+		else {
+			floor = radix.pop().first;
+			if (floor != reference.pop()) return false;
+		}
+	}
+	return radix.size() == reference.size();
+}
+
+int main() {
+	std::mt19937_64 rng(42);
+	uint64_t checksum = 0;
+
+	if (!selfCheck()) {
+		std::printf("self check failed!\n");
+		return 1;
+	}
+
+	std::printf("dijkstra, time (ms)\n%10s %6s %12s %12s\n", "nodes", "degree", "minHeap", "radixHeap");
+	for (size_t nodes : { 10000, 100000, 1000000 }) {
+		for (size_t degree : { 4, 16 }) {
+			graph g = randomGraph(nodes, degree, rng);
+			uint64_t a = 0, b = 0;
+			double binary = dijkstra<binaryQueue>(g, a);
+			double radix = dijkstra<radixQueue>(g, b);
+			std::printf("%10zu %6zu %12.1f %12.1f%s\n", nodes, degree, binary, radix, a == b ? "" : "   mismatch!");
+		}
+	}
+
+	std::printf("\nevent queue, 10M steps, ns/step\n%10s %10s %12s %12s\n", "pending", "max delay", "minHeap", "radixHeap");
+	const size_t steps = 10000000;
+	for (size_t pending : { 1000, 100000, 1000000 }) {
+		for (uint64_t max_delay : { 1000, 1000000000 }) {
+			double binary = events<binaryQueue>(pending, steps, max_delay, checksum);
+			double radix = events<radixQueue>(pending, steps, max_delay, checksum);
+			std::printf("%10zu %10llu %12.1f %12.1f\n", pending, (unsigned long long)max_delay, binary * 1e6 / steps, radix * 1e6 / steps);
+		}
+	}
+	std::printf("(%llu)\n", (unsigned long long)checksum);
+	return 0;
+}
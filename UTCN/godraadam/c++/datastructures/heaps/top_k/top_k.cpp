@@ -0,0 +1,182 @@
+/*
+Author: godraadam @ utcn 2019
+Description: streaming top-k selector, keeps the k highest priority items seen so far in a heap of size k
+			 the root of the heap is the worst item kept, the threshold a new item has to beat,
+			 a better item replaces it with a single popAndPush()
+			 push_bulk() over arrays of int32, int64, float or double ordered by std::less or std::greater
+			 compares whole blocks against the threshold with SSE2 / AVX2 (when compiled with -mavx2 / -march=native)
+			 and only hands the few items that beat it to the heap
+			 selectors filled by different threads can be merged at the end
+			 the order is given by the Compare type, compare(a, b) returns true if a belongs below b
+			 (std::less keeps the k largest items, std::greater the k smallest)
+Operations: push()	-> O(1) if the item does not beat the threshold, O(log k) otherwise
+			push_bulk() -> O(n) plus O(log k) for each item that beats the threshold
+			merge()	-> O(k log k)
+			threshold() -> O(1)
+			drain()	-> O(k log k)
+			size()	-> O(1)
+			full()	-> O(1)
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../binary_heap/binary_heap.cpp"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+template <class T, class Compare = std::less<T>>
+
+class topK final {
+
+	//Heap order with the worst kept item on top
+	private: struct reversed {
+		Compare compare;
+		bool operator()(const T& a, const T& b) {
+			return compare(b, a);
+		}
+	};
+
+	//True if the selector keeps the largest / the smallest of plain arithmetic items
+	private: static constexpr bool maximum = std::is_arithmetic<T>::value && std::is_same<Compare, std::less<T>>::value;
+	private: static constexpr bool minimum = std::is_arithmetic<T>::value && std::is_same<Compare, std::greater<T>>::value;
+
+	//Number of items compared at once by the vectorized filter, 0 if there is none for T
+#if defined(__AVX2__)
+	private: static const size_t block = (maximum || minimum) && (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value ||
+		std::is_same<T, float>::value || std::is_same<T, double>::value) ? 32 / sizeof(T) : 0;
+#elif defined(__SSE2__)
+	private: static const size_t block = (maximum || minimum) && (std::is_same<T, int32_t>::value ||
+		std::is_same<T, float>::value || std::is_same<T, double>::value) ? 16 / sizeof(T) : 0;
+#else
+	private: static const size_t block = 0;
+#endif
+
+	//Fields_____________________________________
+
+	//The kept items, worst on top
+	private: binaryHeap<T, reversed> heap;
+
+	//Ordering of the items
+	private: Compare compare;
+
+	//Methods_____________________________________
+
+	//Constructor keeping the best k items
+	public: topK(size_t k) : heap(check(k)) {}
+
+	public: topK(const topK&) = delete;
+	public: topK& operator=(const topK&) = delete;
+
+	//Offer an item, kept only if fewer than k items were seen or it beats the threshold
+	public: void push(T item) {
+		if (!heap.full()) heap.push(std::move(item));
+		else if (compare(heap.peek(), item)) heap.popAndPush(std::move(item));
+	}
+
+	//Offer count items from the array
+	public: void push_bulk(const T* items, size_t count) {
+		size_t i = 0;
+		for (; i < count && !heap.full(); i++) heap.push(items[i]);
+		if constexpr (block != 0) i = filter(items, i, count);
+		for (; i < count; i++) push(items[i]);
+	}
+
+	//Offer all items kept by other, which is left empty, used to combine the selectors of several threads
+	public: void merge(topK& other) {
+		if (&other == this) return;
+		while (!other.heap.empty()) push(other.heap.pop());
+	}
+
+	//Returns the worst item kept, an item has to beat it to be kept once the selector is full
+	public: T threshold() {
+		if (heap.empty()) throw std::length_error("Selector is empty!");
+		return heap.peek();
+	}
+
+	//Move the kept items into out, best first, and empty the selector, returns the number of items
+	public: size_t drain(T* out) {
+		size_t count = heap.size();
+		for (size_t i = count; i-- > 0;) out[i] = heap.pop();
+		return count;
+	}
+
+	//Returns the number of items kept
+	public: size_t size() {
+		return heap.size();
+	}
+
+	//Returns true once k items are kept
+	public: bool full() {
+		return heap.full();
+	}
+
+	//Returns k
+	public: size_t k() {
+		return heap.maxSize();
+	}
+
+	//Helpers______________________________________________________
+
+	private: static size_t check(size_t k) {
+		if (k == 0) throw std::length_error("Invalid size!");
+		return k;
+	}
+
+	//Offer the items of whole blocks in [from, count) that beat the threshold, returns where the blocks end
+	private: size_t filter(const T* items, size_t from, size_t count) {
+		size_t i = from;
+		for (; i + block <= count; i += block) {
+			unsigned mask = beating(items + i, heap.peek());
+			while (mask != 0) {
+				push(items[i + __builtin_ctz(mask)]);
+				mask &= mask - 1;
+			}
+		}
+		return i;
+	}
+
+	//Returns a bitmask of the items in the block at items that beat limit
+	private: static unsigned beating(const T* items, T limit) {
+#if defined(__AVX2__)
+		if constexpr (std::is_same<T, int32_t>::value) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+			__m256i t = _mm256_set1_epi32(limit);
+			return _mm256_movemask_ps(_mm256_castsi256_ps(maximum ? _mm256_cmpgt_epi32(v, t) : _mm256_cmpgt_epi32(t, v)));
+		}
+		if constexpr (std::is_same<T, int64_t>::value) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+			__m256i t = _mm256_set1_epi64x(limit);
+			return _mm256_movemask_pd(_mm256_castsi256_pd(maximum ? _mm256_cmpgt_epi64(v, t) : _mm256_cmpgt_epi64(t, v)));
+		}
+		if constexpr (std::is_same<T, float>::value)
+			return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(items), _mm256_set1_ps(limit), maximum ? _CMP_GT_OQ : _CMP_LT_OQ));
+		if constexpr (std::is_same<T, double>::value)
+			return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(items), _mm256_set1_pd(limit), maximum ? _CMP_GT_OQ : _CMP_LT_OQ));
+#elif defined(__SSE2__)
+		if constexpr (std::is_same<T, int32_t>::value) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items));
+			__m128i t = _mm_set1_epi32(limit);
+			return _mm_movemask_ps(_mm_castsi128_ps(maximum ? _mm_cmpgt_epi32(v, t) : _mm_cmpgt_epi32(t, v)));
+		}
+		if constexpr (std::is_same<T, float>::value) {
+			__m128 v = _mm_loadu_ps(items);
+			__m128 t = _mm_set1_ps(limit);
+			return _mm_movemask_ps(maximum ? _mm_cmpgt_ps(v, t) : _mm_cmplt_ps(v, t));
+		}
+		if constexpr (std::is_same<T, double>::value) {
+			__m128d v = _mm_loadu_pd(items);
+			__m128d t = _mm_set1_pd(limit);
+			return _mm_movemask_pd(maximum ? _mm_cmpgt_pd(v, t) : _mm_cmplt_pd(v, t));
+		}
+#endif
+		(void)items;
+		(void)limit;
+		return 0;
+	}
+};
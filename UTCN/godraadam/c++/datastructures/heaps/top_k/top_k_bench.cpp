@@ -0,0 +1,100 @@
+/*
+Author: godraadam @ utcn 2019
+Description: throughput of top-k selection over a stream of random scores, k = 10, 1000 and 100000
+			 minHeap by hand: the loop over minHeap::popAndPush() the selector replaces
+			 topK push(): one item at a time, topK push_bulk(): vectorized threshold filter over blocks of the stream
+			 per-thread: every hardware thread runs push_bulk() on its part of the stream, the selectors are merged
+Build: g++ -O2 -std=c++17 -march=native -pthread top_k_bench.cpp -o top_k_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../binary_min_heap/binary_min_heap.cpp"
+#include "top_k.cpp"
+
+template <class F>
+static double rate(size_t n, F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return n / seconds / 1e6;
+}
+
+template <class T>
+static T sum(T* items, size_t n) {
+	T total = 0;
+	for (size_t i = 0; i < n; i++) total += items[i];
+	return total;
+}
+
+template <class T>
+static void run(const char* type, const std::vector<T>& scores, size_t k) {
+	size_t n = scores.size();
+	std::vector<T> out(k);
+	T expected = 0, got = 0;
+
+	double manual = rate(n, [&] {
+		minHeap<T> heap(k);
+		for (T score : scores) {
+			if (!heap.full()) heap.push(score);
+			else if (heap.peek() < score) heap.popAndPush(score);
+		}
+		for (size_t i = k; i-- > 0;) out[i] = heap.pop();
+		expected = sum(out.data(), k);
+	});
+
+	double single = rate(n, [&] {
+		topK<T> top(k);
+		for (T score : scores) top.push(score);
+		got = sum(out.data(), top.drain(out.data()));
+	});
+	bool ok = got == expected;
+
+	double bulk = rate(n, [&] {
+		topK<T> top(k);
+		top.push_bulk(scores.data(), n);
+		got = sum(out.data(), top.drain(out.data()));
+	});
+	ok = ok && got == expected;
+
+	size_t threads = std::thread::hardware_concurrency();
+	if (threads == 0) threads = 1;
+	double parallel = rate(n, [&] {
+		std::vector<std::unique_ptr<topK<T>>> local;
+		for (size_t t = 0; t < threads; t++) local.emplace_back(new topK<T>(k));
+		std::vector<std::thread> workers;
+		for (size_t t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				size_t from = n / threads * t, to = t + 1 == threads ? n : n / threads * (t + 1);
+				local[t]->push_bulk(scores.data() + from, to - from);
+			});
+		}
+		for (std::thread& w : workers) w.join();
+		for (size_t t = 1; t < threads; t++) local[0]->merge(*local[t]);
+		got = sum(out.data(), local[0]->drain(out.data()));
+	});
+	ok = ok && got == expected;
+
+	std::printf("%-8s %8zu %14.1f %14.1f %14.1f %14.1f%s\n", type, k, manual, single, bulk, parallel, ok ? "" : "   mismatch!");
+}
+
+int main() {
+	const size_t n = 50000000;
+	std::mt19937_64 rng(42);
+	std::vector<int32_t> ints(n);
+	std::vector<double> doubles(n);
+	for (size_t i = 0; i < n; i++) {
+		ints[i] = (int32_t)(rng() >> 33);
+		doubles[i] = (double)(rng() >> 11) / (double)(1ull << 53);
+	}
+
+	std::printf("%zu scores, millions of scores per second\n", n);
+	std::printf("%-8s %8s %14s %14s %14s %14s\n", "scores", "k", "minHeap", "topK push", "push_bulk", "per-thread");
+	for (size_t k : { 10, 1000, 100000 }) run("int32", ints, k);
+	for (size_t k : { 10, 1000, 100000 }) run("double", doubles, k);
+	return 0;
+}
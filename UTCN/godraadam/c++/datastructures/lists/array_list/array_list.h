@@ -3,6 +3,15 @@
 /*
 Author: godraadam @ utcn 2019
 Description: generic list data structure implemented using a dynamic array
+			 the array is uninitialized memory, items are constructed in place, destroyed when removed
+			 and moved whenever they are relocated
+			 the array grows geometrically by a growth factor that can be chosen per list,
+			 trivially copyable items are relocated with memcpy / memmove, large arrays of them
+			 are grown in place with realloc (which can remap the pages instead of copying them)
+			 insert(), remove(), trim() and growth all go through the same relocation helpers
+			 find(), find_last(), count() and contains() compare whole vectors of arithmetic items at once,
+			 with SSE2, AVX2 or AVX-512 as CPUID reports them at runtime (g++ / clang on x86),
+			 other items and other targets are searched one by one
 Operations:
 			CREATE
 			new list(array[n]) -> O(n)
@@ -11,6 +20,8 @@ Operations:
 			INSERT OPERATIONS
 			push()		-> O(n)
 			append()	-> O(1) (amortized time)
+			emplace_back() -> O(1) (amortized time)
+			emplace(i)	-> O(n - i)
 			insert(i)	-> O(n - i) 
 			set(i)		-> O(1)
 
@@ -25,22 +36,58 @@ Operations:
 			end()		-> O(1)
 			at(i)		-> O(i)
 			find()		-> O(n)
+			find_last()	-> O(n)
+			count()		-> O(n)
 
 			OTHER
 			empty()		-> O(1)
 			contains()	-> O(n)
 			length()	-> O(1)
 			trim()		-> O(n)
+			growth()	-> O(1)
 			toArray()	-> O(n)
 */
 
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 
 template <class T>
 
 class list final {
 
+	//True if items can be relocated as raw bytes, their array then comes from malloc so realloc can grow it
+	private: static constexpr bool relocatable = std::is_trivially_copyable<T>::value && alignof(T) <= alignof(std::max_align_t);
+
+	//True if items are searched with vector compares, which match exactly when == does
+	private: static constexpr bool searchable = std::is_arithmetic<T>::value &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) &&
+		(std::is_integral<T>::value || std::is_same<T, float>::value || std::is_same<T, double>::value);
+
+	//What search() looks for: the first match, the last match or the number of matches
+	private: enum target { first, last, all };
+
+	//Instruction sets search() can use
+	private: enum isa { scalar, sse2, avx2, avx512 };
+
+	//Returned by find() and find_last() if there is no match
+	private: static const size_t none = (size_t)-1;
+
+	//Size in bytes from which relocatable arrays are grown with realloc instead of malloc and memcpy
+	private: static const size_t large = (size_t)1 << 20;
+
 	//Fields_________________________________________________________________________________
 
 	//Space allocated for items. If exceeded, the array containing the list will resize itself
@@ -51,7 +98,7 @@ class list final {
 
 	//Growth factor, by which the array is scaled in size when resizing
 	//Chose it to be approximately phi (the golden ration) because why not
-	private: static const int gf = 1.618;
+	private: double gf = 1.618;
 
 	//Container for the list
 	private: T* _list;
@@ -60,20 +107,31 @@ class list final {
 
 	//Default constructor
 	public: list() {
-		_list = new T[_capacity];
+		_list = allocate(_capacity);
 	}
 
-	//Constructor with custom initial capacity
-	public: list(size_t capacity) {
-		if (capacity <= 0) throw std::bad_array_new_length("Invalid size!");
+	//Constructor with custom initial capacity and growth factor
+	public: list(size_t capacity, double growth = 1.618) {
+		if (capacity <= 0) throw std::length_error("Invalid size!");
+		if (!(growth > 1)) throw std::invalid_argument("Invalid growth factor!");
 		_capacity = capacity;
-		_list = new T[_capacity];
+		gf = growth;
+		_list = allocate(_capacity);
+	}
+
+	//The container is owned by the list, copying it would free it twice
+	public: list(const list&) = delete;
+	public: list& operator=(const list&) = delete;
+
+	//Destructor, destroys the items and releases the container
+	public: ~list() {
+		destroy(0);
+		deallocate(_list, _capacity);
 	}
 
 	//Add new item to the front of the list
 	public: void push(T item) {
-		if (_size == _capacity) resize();
-		insert(item, 0);
+		emplace(0, std::move(item));
 	}
 
 	//Remove and return item from front of the list
@@ -84,22 +142,40 @@ class list final {
 
 	//Add item to the end of the list
 	public: void append(T item) {
-		if (_size == _capacity) resize();
-		_list[_size++] = item;
+		emplace_back(std::move(item));
+	}
+
+	//Construct item at the end of the list from the given arguments
+	public: template<class... Args> void emplace_back(Args&&... args) {
+		if (_size == _capacity) relocate(grown(), _size);
+		new (_list + _size) T(std::forward<Args>(args)...);
+		_size++;
 	}
 	
 	//Remove and return item from the end of the list
 	public: T trunc() {
 		if (empty()) throw std::length_error("List is empty!");
-		return _list[--_size];
+		T ret = std::move(_list[--_size]);
+		_list[_size].~T();
+		return ret;
 	}
 
 	//Insert item at given index
 	public: void insert(T item, size_t index) {
-		if (index < 0 || index > _size) throw std::length_error("Index is out of bounds!");
-		if (_size == _capacity) resize();
-		memcpy(_list + index + 1, _list + index, sizeof(T) * (_size - index));
-		_list[index] = item;
+		emplace(index, std::move(item));
+	}
+
+	//Construct item from the given arguments and insert it at given index
+	public: template<class... Args> void emplace(size_t index, Args&&... args) {
+		if (index > _size) throw std::length_error("Index is out of bounds!");
+		if (index == _size) {
+			emplace_back(std::forward<Args>(args)...);
+			return;
+		}
+		T item(std::forward<Args>(args)...);
+		if (_size == _capacity) relocate(grown(), index);
+		else open(index);
+		new (_list + index) T(std::move(item));
 		_size++;
 	}
 	
@@ -108,8 +184,9 @@ class list final {
 		if (!range(index)) throw std::length_error("Index is out of bounds!");
 		if (empty()) throw std::length_error("List is empty!");
 
-		T ret = _list[index];
-		memcpy(_list + index, _list + index + 1, sizeof(T) * (_size - index));
+		T ret = std::move(_list[index]);
+		_list[index].~T();
+		close(index);
 		_size--;
 		return ret;
 	}
@@ -117,14 +194,22 @@ class list final {
 	//Change the value of the item at given index to given value
 	public: void set(size_t index, T item) {
 		if (!range(index)) throw std::length_error("Index is out of bounds!");
-		_list[index] = item;
+		_list[index] = std::move(item);
 	}
 
 	//Returns the index of the first occurence of given item, -1 if not found
 	public: size_t find(T item) {
-		for (int i = 0; i < _size; i++)
-			if (_list[i] == item) return i;
-		return -1;
+		return search(item, first);
+	}
+
+	//Returns the index of the last occurence of given item, -1 if not found
+	public: size_t find_last(T item) {
+		return search(item, last);
+	}
+
+	//Returns the number of occurences of given item
+	public: size_t count(T item) {
+		return search(item, all);
 	}
 
 	//Returns current capacity of the list
@@ -162,44 +247,351 @@ class list final {
 
 	//Returns true only if the given item is in the list
 	public: bool contains(T item) {
-		return (int) find(item) >= 0;
+		return find(item) != none;
 	}
 
 	//Reset the list
 	public: void clear() {
-		_size = 10;
-		trim();
-		_size = 0;
+		destroy(0);
+		relocate(10, 0);
 	}
 
-	//Resize the list to current size
+	//Resize the list to current size, keeping room for one item in an empty list
 	public: void trim() {
-		_capacity = _size;
-		T* tmp = new T[_capacity];
-		memmove(tmp, _list, sizeof(T) * _size);
-		_list = tmp;
+		relocate(std::max(_size, (size_t)1), _size);
+	}
+
+	//Returns the growth factor
+	public: double growth() {
+		return gf;
 	}
 
 	//Returns an array with the curresnt size of the list containg the same items
 	public: T* toArray() {
 		T* tmp = new T[_size];
-		memcpy(tmp, _list, sizeof(T) * _size);
+		std::copy(_list, _list + _size, tmp);
 		return tmp;
 	}
 
 	//Helpers____________________________________________________________________________
 
-	//Scale the capacity of the container by growth factor
-	private: void resize() {
-		T* tmp = new T[_capacity];
-		memmove(tmp, _list, sizeof(T) * _size);
-		_list = new T[(int)(_capacity * gf)];
-		memmove(_list, tmp, sizeof(T) * _size);
+	//Capacity after scaling the container by growth factor, at least one more slot
+	private: size_t grown() {
+		size_t capacity = (size_t)(_capacity * gf);
+		return capacity > _capacity ? capacity : _capacity + 1;
+	}
+
+	//Move the items to a new container of given capacity, leaving an uninitialized slot at index gap
+	//(the items from gap on move one slot further), gap == _size leaves no hole between the items
+	private: void relocate(size_t capacity, size_t gap) {
+		if constexpr (relocatable) {
+			if (capacity * sizeof(T) >= large && _capacity * sizeof(T) >= large) {
+				//realloc keeps or remaps the pages, only the items after the gap move
+				T* tmp = static_cast<T*>(std::realloc(_list, capacity * sizeof(T)));
+				if (tmp == nullptr) throw std::bad_alloc();
+				if (gap < _size) std::memmove(tmp + gap + 1, tmp + gap, (_size - gap) * sizeof(T));
+				_list = tmp;
+				_capacity = capacity;
+				return;
+			}
+		}
+		T* tmp = allocate(capacity);
+		if constexpr (relocatable) {
+			std::memcpy(tmp, _list, gap * sizeof(T));
+			//With no hole tmp + gap + 1 may lie past the end of the new array, as in trim()
+			if (gap < _size) std::memcpy(tmp + gap + 1, _list + gap, (_size - gap) * sizeof(T));
+		}
+		else {
+			for (size_t i = 0; i < _size; i++) {
+				new (tmp + i + (i >= gap)) T(std::move(_list[i]));
+				_list[i].~T();
+			}
+		}
+		deallocate(_list, _capacity);
+		_list = tmp;
+		_capacity = capacity;
+	}
+
+	//Shift the items from index on one slot towards the end, leaving an uninitialized slot at index
+	//There must be room for one more item
+	private: void open(size_t index) {
+		if constexpr (relocatable) std::memmove(_list + index + 1, _list + index, (_size - index) * sizeof(T));
+		else if (index < _size) {
+			new (_list + _size) T(std::move(_list[_size - 1]));
+			std::move_backward(_list + index, _list + _size - 1, _list + _size);
+			_list[index].~T();
+		}
+	}
+
+	//Shift the items after the uninitialized slot at index one slot towards the front, closing it
+	//_size still counts the slot
+	private: void close(size_t index) {
+		if constexpr (relocatable) std::memmove(_list + index, _list + index + 1, (_size - index - 1) * sizeof(T));
+		else if (index + 1 < _size) {
+			new (_list + index) T(std::move(_list[index + 1]));
+			std::move(_list + index + 2, _list + _size, _list + index + 1);
+			_list[_size - 1].~T();
+		}
+	}
+
+	//Destroy every item from given index to the end of the list
+	private: void destroy(size_t from) {
+		while (_size > from) _list[--_size].~T();
+	}
+
+	//Uninitialized memory for given number of items
+	private: static T* allocate(size_t capacity) {
+		if constexpr (relocatable) {
+			void* container = std::malloc(std::max(capacity, (size_t)1) * sizeof(T));
+			if (container == nullptr) throw std::bad_alloc();
+			return static_cast<T*>(container);
+		}
+		else return std::allocator<T>().allocate(capacity);
+	}
+
+	//Release a container obtained from allocate()
+	private: static void deallocate(T* container, size_t capacity) {
+		if constexpr (relocatable) std::free(container);
+		else std::allocator<T>().deallocate(container, capacity);
+	}
+
+	//Find the first or last occurence of item or count its occurences, with the best kernel for T and the CPU
+	private: size_t search(const T& item, target kind) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		if constexpr (searchable) {
+			switch (best()) {
+			case avx512: return scan_avx512(_list, _size, item, kind);
+			case avx2: return scan_avx2(_list, _size, item, kind);
+			case sse2: return scan_sse2(_list, _size, item, kind);
+			default: break;
+			}
+		}
+#endif
+		return scan(_list, 0, _size, item, kind, 0);
+	}
+
+	//Scalar search of [from, to), found is the number of matches already counted before from
+	private: static size_t scan(const T* items, size_t from, size_t to, const T& item, target kind, size_t found) {
+		if (kind == last) {
+			for (size_t i = to; i-- > from;)
+				if (items[i] == item) return i;
+			return none;
+		}
+		for (size_t i = from; i < to; i++) {
+			if (items[i] == item) {
+				if (kind == first) return i;
+				found++;
+			}
+		}
+		return kind == first ? none : found;
+	}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	//Best instruction set of the CPU, asked from CPUID once
+	private: static isa best() {
+		static const isa detected = [] {
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return avx512;
+			if (__builtin_cpu_supports("avx2")) return avx2;
+			if (__builtin_cpu_supports("sse2")) return sse2;
+			return scalar;
+		}();
+		return detected;
+	}
+
+	//The bits of item as an integer of the same size, to broadcast it into a vector
+	private: static int64_t bits(const T& item) {
+		if constexpr (sizeof(T) == 1) { int8_t b; std::memcpy(&b, &item, 1); return b; }
+		else if constexpr (sizeof(T) == 2) { int16_t b; std::memcpy(&b, &item, 2); return b; }
+		else if constexpr (sizeof(T) == 4) { int32_t b; std::memcpy(&b, &item, 4); return b; }
+		else { int64_t b; std::memcpy(&b, &item, 8); return b; }
+	}
+
+	//Each kernel compares blocks of one vector against item and turns the result into a bitmask,
+	//SSE2 and AVX2 masks have sizeof(T) bits per item, AVX-512 masks one bit per item
+	//The first and last searches look at four vectors per step and only pick the match out of a step that has one
+
+	//Bitmask of the items of the 16 byte block at p equal to item
+	private: __attribute__((target("sse2"))) static unsigned match_sse2(const T* p, __m128i v) {
+		if constexpr (std::is_same<T, float>::value)
+			return _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), _mm_castsi128_ps(v))));
+		else if constexpr (std::is_same<T, double>::value)
+			return _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(p), _mm_castsi128_pd(v))));
+		else {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			if constexpr (sizeof(T) == 1) return _mm_movemask_epi8(_mm_cmpeq_epi8(x, v));
+			else if constexpr (sizeof(T) == 2) return _mm_movemask_epi8(_mm_cmpeq_epi16(x, v));
+			else if constexpr (sizeof(T) == 4) return _mm_movemask_epi8(_mm_cmpeq_epi32(x, v));
+			else {
+				//No 64 bit compare before SSE4.1, both 32 bit halves have to match
+				__m128i c = _mm_cmpeq_epi32(x, v);
+				return _mm_movemask_epi8(_mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1))));
+			}
+		}
+	}
+
+	private: __attribute__((target("sse2"))) static size_t scan_sse2(const T* items, size_t n, const T& item, target kind) {
+		const size_t width = 16 / sizeof(T);
+		__m128i v;
+		if constexpr (sizeof(T) == 1) v = _mm_set1_epi8((char)bits(item));
+		else if constexpr (sizeof(T) == 2) v = _mm_set1_epi16((short)bits(item));
+		else if constexpr (sizeof(T) == 4) v = _mm_set1_epi32((int)bits(item));
+		else v = _mm_set1_epi64x(bits(item));
+
+		if (kind == first) {
+			size_t i = 0;
+			for (; i + 4 * width <= n; i += 4 * width) {
+				unsigned m[4] = { match_sse2(items + i, v), match_sse2(items + i + width, v),
+					match_sse2(items + i + 2 * width, v), match_sse2(items + i + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 0; j < 4; j++)
+					if (m[j] != 0) return i + j * width + __builtin_ctz(m[j]) / sizeof(T);
+			}
+			for (; i + width <= n; i += width) {
+				unsigned m = match_sse2(items + i, v);
+				if (m != 0) return i + __builtin_ctz(m) / sizeof(T);
+			}
+			return scan(items, i, n, item, kind, 0);
+		}
+		if (kind == last) {
+			size_t i = n;
+			for (; i >= 4 * width; i -= 4 * width) {
+				const T* p = items + i - 4 * width;
+				unsigned m[4] = { match_sse2(p, v), match_sse2(p + width, v), match_sse2(p + 2 * width, v), match_sse2(p + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 4; j-- > 0;)
+					if (m[j] != 0) return i - (4 - j) * width + (31 - __builtin_clz(m[j])) / sizeof(T);
+			}
+			for (; i >= width; i -= width) {
+				unsigned m = match_sse2(items + i - width, v);
+				if (m != 0) return i - width + (31 - __builtin_clz(m)) / sizeof(T);
+			}
+			return scan(items, 0, i, item, kind, 0);
+		}
+		size_t found = 0, i = 0;
+		for (; i + width <= n; i += width) found += __builtin_popcount(match_sse2(items + i, v));
+		return scan(items, i, n, item, kind, found / sizeof(T));
+	}
+
+	//Bitmask of the items of the 32 byte block at p equal to item
+	private: __attribute__((target("avx2"))) static unsigned match_avx2(const T* p, __m256i v) {
+		if constexpr (std::is_same<T, float>::value)
+			return _mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_castsi256_ps(v), _CMP_EQ_OQ)));
+		else if constexpr (std::is_same<T, double>::value)
+			return _mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_castsi256_pd(v), _CMP_EQ_OQ)));
+		else {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			if constexpr (sizeof(T) == 1) return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, v));
+			else if constexpr (sizeof(T) == 2) return _mm256_movemask_epi8(_mm256_cmpeq_epi16(x, v));
+			else if constexpr (sizeof(T) == 4) return _mm256_movemask_epi8(_mm256_cmpeq_epi32(x, v));
+			else return _mm256_movemask_epi8(_mm256_cmpeq_epi64(x, v));
+		}
+	}
+
+	private: __attribute__((target("avx2,popcnt"))) static size_t scan_avx2(const T* items, size_t n, const T& item, target kind) {
+		const size_t width = 32 / sizeof(T);
+		__m256i v;
+		if constexpr (sizeof(T) == 1) v = _mm256_set1_epi8((char)bits(item));
+		else if constexpr (sizeof(T) == 2) v = _mm256_set1_epi16((short)bits(item));
+		else if constexpr (sizeof(T) == 4) v = _mm256_set1_epi32((int)bits(item));
+		else v = _mm256_set1_epi64x(bits(item));
+
+		if (kind == first) {
+			size_t i = 0;
+			for (; i + 4 * width <= n; i += 4 * width) {
+				unsigned m[4] = { match_avx2(items + i, v), match_avx2(items + i + width, v),
+					match_avx2(items + i + 2 * width, v), match_avx2(items + i + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 0; j < 4; j++)
+					if (m[j] != 0) return i + j * width + __builtin_ctz(m[j]) / sizeof(T);
+			}
+			for (; i + width <= n; i += width) {
+				unsigned m = match_avx2(items + i, v);
+				if (m != 0) return i + __builtin_ctz(m) / sizeof(T);
+			}
+			return scan(items, i, n, item, kind, 0);
+		}
+		if (kind == last) {
+			size_t i = n;
+			for (; i >= 4 * width; i -= 4 * width) {
+				const T* p = items + i - 4 * width;
+				unsigned m[4] = { match_avx2(p, v), match_avx2(p + width, v), match_avx2(p + 2 * width, v), match_avx2(p + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 4; j-- > 0;)
+					if (m[j] != 0) return i - (4 - j) * width + (31 - __builtin_clz(m[j])) / sizeof(T);
+			}
+			for (; i >= width; i -= width) {
+				unsigned m = match_avx2(items + i - width, v);
+				if (m != 0) return i - width + (31 - __builtin_clz(m)) / sizeof(T);
+			}
+			return scan(items, 0, i, item, kind, 0);
+		}
+		size_t found = 0, i = 0;
+		for (; i + width <= n; i += width) found += __builtin_popcount(match_avx2(items + i, v));
+		return scan(items, i, n, item, kind, found / sizeof(T));
+	}
+
+	//Bitmask of the items of the 64 byte block at p equal to item
+	private: __attribute__((target("avx512f,avx512bw"))) static uint64_t match_avx512(const T* p, __m512i v) {
+		if constexpr (std::is_same<T, float>::value)
+			return _mm512_cmp_ps_mask(_mm512_loadu_ps(p), _mm512_castsi512_ps(v), _CMP_EQ_OQ);
+		else if constexpr (std::is_same<T, double>::value)
+			return _mm512_cmp_pd_mask(_mm512_loadu_pd(p), _mm512_castsi512_pd(v), _CMP_EQ_OQ);
+		else {
+			__m512i x = _mm512_loadu_si512(p);
+			if constexpr (sizeof(T) == 1) return _mm512_cmpeq_epi8_mask(x, v);
+			else if constexpr (sizeof(T) == 2) return _mm512_cmpeq_epi16_mask(x, v);
+			else if constexpr (sizeof(T) == 4) return _mm512_cmpeq_epi32_mask(x, v);
+			else return _mm512_cmpeq_epi64_mask(x, v);
+		}
+	}
+
+	private: __attribute__((target("avx512f,avx512bw,popcnt"))) static size_t scan_avx512(const T* items, size_t n, const T& item, target kind) {
+		const size_t width = 64 / sizeof(T);
+		__m512i v;
+		if constexpr (sizeof(T) == 1) v = _mm512_set1_epi8((char)bits(item));
+		else if constexpr (sizeof(T) == 2) v = _mm512_set1_epi16((short)bits(item));
+		else if constexpr (sizeof(T) == 4) v = _mm512_set1_epi32((int)bits(item));
+		else v = _mm512_set1_epi64(bits(item));
+
+		if (kind == first) {
+			size_t i = 0;
+			for (; i + 4 * width <= n; i += 4 * width) {
+				uint64_t m[4] = { match_avx512(items + i, v), match_avx512(items + i + width, v),
+					match_avx512(items + i + 2 * width, v), match_avx512(items + i + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 0; j < 4; j++)
+					if (m[j] != 0) return i + j * width + __builtin_ctzll(m[j]);
+			}
+			for (; i + width <= n; i += width) {
+				uint64_t m = match_avx512(items + i, v);
+				if (m != 0) return i + __builtin_ctzll(m);
+			}
+			return scan(items, i, n, item, kind, 0);
+		}
+		if (kind == last) {
+			size_t i = n;
+			for (; i >= 4 * width; i -= 4 * width) {
+				const T* p = items + i - 4 * width;
+				uint64_t m[4] = { match_avx512(p, v), match_avx512(p + width, v), match_avx512(p + 2 * width, v), match_avx512(p + 3 * width, v) };
+				if ((m[0] | m[1] | m[2] | m[3]) == 0) continue;
+				for (size_t j = 4; j-- > 0;)
+					if (m[j] != 0) return i - (4 - j) * width + (63 - __builtin_clzll(m[j]));
+			}
+			for (; i >= width; i -= width) {
+				uint64_t m = match_avx512(items + i - width, v);
+				if (m != 0) return i - width + (63 - __builtin_clzll(m));
+			}
+			return scan(items, 0, i, item, kind, 0);
+		}
+		size_t found = 0, i = 0;
+		for (; i + width <= n; i += width) found += __builtin_popcountll(match_avx512(items + i, v));
+		return scan(items, i, n, item, kind, found);
 	}
+#endif
 
 	//Check if given index is valid
-	private: bool range(int index) {
-		if (index < 0 || index >= _size) return false;
-		return true;
+	private: bool range(size_t index) {
+		return index < _size;
 	}
 };
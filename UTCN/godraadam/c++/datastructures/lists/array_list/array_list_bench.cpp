@@ -0,0 +1,73 @@
+/*
+Author: godraadam @ utcn 2019
+Description: search throughput of the list over integer IDs and doubles, lists of 1K to 16M items
+			 std::find / std::count: the scalar loops the list used before, over the same array
+			 contains() looks for an absent ID and find_last() for the first item, which occurs nowhere else,
+			 so both scan the whole list,
+			 count() for an ID that occurs about once per 1000 items
+			 the list picks SSE2, AVX2 or AVX-512 at runtime, no -march flag is needed
+Build: g++ -O2 -std=c++17 array_list_bench.cpp -o array_list_bench
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "array_list.h"
+
+//Runs f repeatedly for at least 0.2 s, returns billions of items scanned per second
+template <class F>
+static double rate(size_t items, F f) {
+	size_t rounds = 0;
+	size_t sink = 0;
+	auto start = std::chrono::steady_clock::now();
+	double seconds = 0;
+	do {
+		sink += f();
+		rounds++;
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	} while (seconds < 0.2);
+	if (sink == 1) std::printf(" ");
+	return items * rounds / seconds / 1e9;
+}
+
+template <class T>
+static void run(const char* type, size_t n) {
+	std::mt19937_64 rng(n);
+	std::vector<T> items(n);
+	list<T> l(n);
+	T absent = (T)1000, head = (T)1001, rare = (T)7;
+	for (size_t i = 0; i < n; i++) {
+		items[i] = i == 0 ? head : (T)(rng() % 1000);
+		l.append(items[i]);
+	}
+	const T* begin = items.data();
+	const T* end = begin + n;
+
+	double scalar_contains = rate(n, [&] { return (size_t)(std::find(begin, end, absent) != end); });
+	double list_contains = rate(n, [&] { return (size_t)l.contains(absent); });
+	double scalar_last = rate(n, [&] {
+		for (size_t i = n; i-- > 0;)
+			if (items[i] == head) return i;
+		return (size_t)-1;
+	});
+	double list_last = rate(n, [&] { return l.find_last(head); });
+	double scalar_count = rate(n, [&] { return (size_t)std::count(begin, end, rare); });
+	double list_count = rate(n, [&] { return l.count(rare); });
+	bool ok = l.count(rare) == (size_t)std::count(begin, end, rare) && !l.contains(absent);
+
+	std::printf("%-8s %10zu %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f%s\n", type, n, scalar_contains, list_contains,
+		scalar_last, list_last, scalar_count, list_count, ok ? "" : "   mismatch!");
+}
+
+int main() {
+	std::printf("billions of items scanned per second\n");
+	std::printf("%-8s %10s %12s %12s %12s %12s %12s %12s\n", "items", "length", "std::find", "contains", "scalar last",
+		"find_last", "std::count", "count");
+	for (size_t n : { 1000, 64000, 1000000, 16000000 }) run<int32_t>("int32", n);
+	for (size_t n : { 1000, 64000, 1000000, 16000000 }) run<int64_t>("int64", n);
+	for (size_t n : { 1000, 64000, 1000000, 16000000 }) run<double>("double", n);
+	return 0;
+}
@@ -0,0 +1,79 @@
+/*
+Author: godraadam @ utcn 2019
+Description: growth and shifting cost of the list against std::vector, best of 3 runs
+			 append: 50M longs into a default constructed list, so the array grows from its smallest size,
+			 trivially copyable items are relocated with memcpy, and with realloc once the array reaches 1 MiB
+			 middle: 100K inserts then 100K removes of ints at the middle of the list, one memmove each
+			 strings: 5M appends of short std::string, moved over item by item on every growth
+			 only the constructor, append(), insert(), remove() and at() are used, so the bench also builds
+			 against older versions of array_list.h
+Build: g++ -O2 -std=c++17 array_list_growth_bench.cpp -o array_list_growth_bench
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "array_list.h"
+
+//Runs f three times, returns the fastest run in milliseconds
+template <class F>
+static double best(F f) {
+	double ms = 0;
+	for (int run = 0; run < 3; run++) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		double t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		ms = run == 0 ? t : std::min(ms, t);
+	}
+	return ms;
+}
+
+int main() {
+	const size_t appends = 50000000, shifts = 100000, strings = 5000000;
+	long sink = 0;
+
+	double list_append = best([&] {
+		list<long> l;
+		for (size_t i = 0; i < appends; i++) l.append((long)i);
+		sink += l.at(appends - 1);
+	});
+	double vector_append = best([&] {
+		std::vector<long> v;
+		for (size_t i = 0; i < appends; i++) v.push_back((long)i);
+		sink += v[appends - 1];
+	});
+
+	double list_middle = best([&] {
+		list<int> l;
+		for (size_t i = 0; i < shifts; i++) l.insert((int)i, l.length() / 2);
+		for (size_t i = 0; i < shifts; i++) sink += l.remove(l.length() / 2);
+	});
+	double vector_middle = best([&] {
+		std::vector<int> v;
+		for (size_t i = 0; i < shifts; i++) v.insert(v.begin() + v.size() / 2, (int)i);
+		for (size_t i = 0; i < shifts; i++) {
+			sink += v[v.size() / 2];
+			v.erase(v.begin() + v.size() / 2);
+		}
+	});
+
+	double list_strings = best([&] {
+		list<std::string> l;
+		for (size_t i = 0; i < strings; i++) l.append(std::to_string(i));
+		sink += (long)l.at(strings - 1).size();
+	});
+	double vector_strings = best([&] {
+		std::vector<std::string> v;
+		for (size_t i = 0; i < strings; i++) v.push_back(std::to_string(i));
+		sink += (long)v[strings - 1].size();
+	});
+
+	std::printf("%-28s %12s %12s\n", "time (ms)", "list", "std::vector");
+	std::printf("%-28s %12.1f %12.1f\n", "append 50M long", list_append, vector_append);
+	std::printf("%-28s %12.1f %12.1f\n", "insert/remove middle 100K", list_middle, vector_middle);
+	std::printf("%-28s %12.1f %12.1f\n", "append 5M std::string", list_strings, vector_strings);
+	std::printf("(%ld)\n", sink);
+	return 0;
+}
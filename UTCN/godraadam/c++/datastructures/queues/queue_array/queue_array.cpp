@@ -1,47 +1,82 @@
 /*
 Author: godraadam @ utcn 2019
 Description: basic, generic queue implementation using array as container
-Operations: enqueue() -> O(1)
+			 the array is a circular buffer with power of two capacity, indices wrap around with a bitmask
+			 a growable queue unrolls the ring into a buffer twice as large when it runs out of space
+			 the array is uninitialized memory, items are constructed in place and destroyed when dequeued
+Operations: enqueue() -> O(1) (amortized time if growable)
+			emplace() -> O(1) (amortized time if growable)
 			dequeue() -> O(1)
-			peek()	  -> O(1)
+			front()	  -> O(1)
+			end()	  -> O(1)
 			empty()	  -> O(1)
 			full()	  -> O(1)
 			size()	  -> O(1)
 */
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 template <class T>
 
 class queue final {
 
 	//Maximum number of items this queue can hold
-	private: size_t max_size = UINT16_MAX;
+	private: size_t max_size = SIZE_MAX;
 
-	//Index of first item
+	//Number of slots in the ring, always a power of two
+	private: size_t _capacity = 16;
+
+	//Bitmask mapping a position to its slot in the ring
+	private: size_t mask = 15;
+
+	//Position of first item, only ever increases
 	private: size_t _front = 0;
 
-	//Index of last item
+	//Position after the last item, only ever increases
 	private: size_t _end = 0;
 
 	//Actual container to store the items
 	private: T *_queue;
 
-	//Default constructor
+	//Default constructor, the queue grows as needed
 	public: queue() {
-		_queue = new T[max_size];
+		_queue = std::allocator<T>().allocate(_capacity);
 	}
 
-	//Constructor with custom size
-	public: queue(size_t max_size) {
-		if (max_size > this->max_size) throw std::bad_array_new_length("Queue size too large!");
+	//Constructor with custom size, the queue holds at most max_size items
+	public: queue(size_t max_size) : queue(max_size, false) {
 		this->max_size = max_size;
-		_queue = new T[max_size];
+	}
+
+	//Constructor with custom initial capacity, rounded up to a power of two
+	//A queue that is not growable is full once the ring is
+	public: queue(size_t capacity, bool growable) {
+		if (capacity == 0 || capacity > (SIZE_MAX >> 1) + 1) throw std::length_error("Invalid size!");
+		_capacity = 1;
+		while (_capacity < capacity) _capacity <<= 1;
+		mask = _capacity - 1;
+		if (!growable) max_size = _capacity;
+		_queue = std::allocator<T>().allocate(_capacity);
+	}
+
+	//The container is owned by the queue, copying it would free it twice
+	public: queue(const queue&) = delete;
+	public: queue& operator=(const queue&) = delete;
+
+	//Destructor, destroys the remaining items and releases the container
+	public: ~queue() {
+		for (size_t i = _front; i != _end; i++) _queue[i & mask].~T();
+		std::allocator<T>().deallocate(_queue, _capacity);
 	}
 
 	//Returns current number of items in queue
 	public: size_t size() {
-		return _front - _end;
+		return _end - _front;
 	}
 
 	//Return true only if queue is empty
@@ -51,36 +86,67 @@ class queue final {
 
 	//Returns true only if queue is full
 	public: bool full() {
-		return _front - _end == max_size;
+		return size() == max_size;
+	}
+
+	//Returns the number of items the ring can hold before it has to grow
+	public: size_t capacity() {
+		return _capacity;
 	}
 
 	//Returns the item at the front of the queue, i.e. the one added first
 	public: T front() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		return _queue[_front];
+		return _queue[_front & mask];
 	}
 
 	//Return the item at the end of the queue, i.e. the one added last
 	public: T end() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		return _queue[_end - 1];
+		return _queue[(_end - 1) & mask];
 	}
 
 	//Add item to the end of the queue
 	public: void enqueue(T item) {
+		emplace(std::move(item));
+	}
+
+	//Construct item at the end of the queue from the given arguments
+	public: template<class... Args> void emplace(Args&&... args) {
 		if (full()) throw std::length_error("Queue is full!");
-		_queue[_end++] = item;
+		if (size() == _capacity) grow();
+		new (_queue + (_end & mask)) T(std::forward<Args>(args)...);
+		_end++;
 	}
 
-	//Removes item from end of the queue and returns it
+	//Removes item from the front of the queue and returns it
 	public: T dequeue() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		//When queue is emptied out, reset
-		if (size() == 1) {
-			T ret = _queue[_front];
-			_front = _end = 0;
-			return ret;
+		T& item = _queue[_front & mask];
+		T ret = std::move(item);
+		item.~T();
+		_front++;
+		return ret;
+	}
+
+	//Helpers______________________________________
+
+	//Double the ring, moving the items to the start of the new buffer in queue order
+	private: void grow() {
+		if (_capacity > (SIZE_MAX >> 1)) throw std::length_error("Queue size too large!");
+		size_t capacity = _capacity << 1;
+		T* tmp = std::allocator<T>().allocate(capacity);
+		size_t count = size();
+		for (size_t i = 0; i < count; i++) {
+			T& item = _queue[(_front + i) & mask];
+			new (tmp + i) T(std::move(item));
+			item.~T();
 		}
-		return _queue[_front++];
+		std::allocator<T>().deallocate(_queue, _capacity);
+		_queue = tmp;
+		_capacity = capacity;
+		mask = capacity - 1;
+		_front = 0;
+		_end = count;
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,180 @@
+/*
+Author: godraadam @ utcn 2019
+Description: thread-safe, generic blocking queue using the linked list queue as container
+			 consumers with nothing to do sleep on a condition variable instead of spinning
+			 producers only notify when a consumer is parked and has not already been woken, so a burst
+			 of items costs a single wakeup for a consumer that drains it with dequeue_up_to()
+			 close() wakes every consumer, waits then fail once the queue is empty
+Operations: enqueue()		   -> O(1)
+			enqueue_bulk()	   -> O(k)
+			try_dequeue()	   -> O(1)
+			wait_dequeue()	   -> O(1) (blocks until an item is available)
+			wait_dequeue_for() -> O(1) (blocks until an item is available or the timeout expires)
+			dequeue_up_to()	   -> O(k) (blocks until at least one item is available)
+			close()			   -> O(1)
+			empty()			   -> O(1)
+			size()			   -> O(1)
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "../queue_list/queue_list.cpp"
+
+template <class T>
+
+class blockingQueue final {
+
+	//Fields_______________________________________
+
+	//Actual container to store the items
+	private: queue<T> _queue;
+
+	//Guards every other field
+	private: std::mutex lock;
+
+	//Parked consumers wait here
+	private: std::condition_variable ready;
+
+	//Number of consumers currently parked
+	private: size_t waiting = 0;
+
+	//Number of notifications sent to parked consumers that have not woken up yet
+	private: size_t wakeups = 0;
+
+	//Once set, no more items are accepted and consumers stop waiting
+	private: bool closed = false;
+
+	//Methods______________________________________
+
+	//Default constructor
+	public: blockingQueue() {}
+
+	public: blockingQueue(const blockingQueue&) = delete;
+	public: blockingQueue& operator=(const blockingQueue&) = delete;
+
+	//Add item to the end of the queue
+	public: void enqueue(T item) {
+		bool notify;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (closed) throw std::logic_error("Queue is closed!");
+			_queue.enqueue(std::move(item));
+			notify = claimWakeups(1) > 0;
+		}
+		if (notify) ready.notify_one();
+	}
+
+	//Add count items from the given array to the end of the queue under a single lock
+	//Wakes at most one parked consumer per item
+	public: void enqueue_bulk(T* items, size_t count) {
+		if (count == 0) return;
+		size_t notify;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (closed) throw std::logic_error("Queue is closed!");
+			for (size_t i = 0; i < count; i++) _queue.enqueue(std::move(items[i]));
+			notify = claimWakeups(count);
+		}
+		if (notify == 1) ready.notify_one();
+		else if (notify > 1) ready.notify_all();
+	}
+
+	//Remove the item at the front of the queue into item without waiting, returns false if the queue is empty
+	public: bool try_dequeue(T& item) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (_queue.empty()) return false;
+		item = _queue.dequeue();
+		return true;
+	}
+
+	//Remove the item at the front of the queue into item, waiting for one if needed
+	//Returns false only if the queue is closed and empty
+	public: bool wait_dequeue(T& item) {
+		std::unique_lock<std::mutex> guard(lock);
+		while (_queue.empty() && !closed) park(guard);
+		if (_queue.empty()) return false;
+		item = _queue.dequeue();
+		return true;
+	}
+
+	//Remove the item at the front of the queue into item, waiting at most timeout for one
+	//Returns false if the timeout expired or the queue is closed and empty
+	public: template<class Rep, class Period> bool wait_dequeue_for(T& item, std::chrono::duration<Rep, Period> timeout) {
+		auto deadline = std::chrono::steady_clock::now() + timeout;
+		std::unique_lock<std::mutex> guard(lock);
+		while (_queue.empty() && !closed) {
+			if (!park(guard, deadline)) break;
+		}
+		if (_queue.empty()) return false;
+		item = _queue.dequeue();
+		return true;
+	}
+
+	//Remove up to max items from the front of the queue into the given array, waiting for at least one
+	//Returns the number of items removed, 0 only if the queue is closed and empty
+	public: size_t dequeue_up_to(T* items, size_t max) {
+		if (max == 0) return 0;
+		std::unique_lock<std::mutex> guard(lock);
+		while (_queue.empty() && !closed) park(guard);
+		size_t count = 0;
+		while (count < max && !_queue.empty()) items[count++] = _queue.dequeue();
+		return count;
+	}
+
+	//Stop accepting items and wake every parked consumer
+	public: void close() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			closed = true;
+		}
+		ready.notify_all();
+	}
+
+	//Returns true only if queue is empty
+	public: bool empty() {
+		std::lock_guard<std::mutex> guard(lock);
+		return _queue.empty();
+	}
+
+	//Returns current number of items in queue
+	public: size_t size() {
+		std::lock_guard<std::mutex> guard(lock);
+		return _queue.size();
+	}
+
+	//Helpers______________________________________
+
+	//Returns how many parked consumers should be woken for count new items and books them as woken
+	private: size_t claimWakeups(size_t count) {
+		size_t idle = waiting - wakeups;
+		size_t notify = count < idle ? count : idle;
+		wakeups += notify;
+		return notify;
+	}
+
+	//Sleep until notified
+	private: void park(std::unique_lock<std::mutex>& guard) {
+		waiting++;
+		ready.wait(guard);
+		unpark();
+	}
+
+	//Sleep until notified or the deadline passes, returns false once the deadline has passed
+	private: bool park(std::unique_lock<std::mutex>& guard, std::chrono::steady_clock::time_point deadline) {
+		waiting++;
+		bool notified = ready.wait_until(guard, deadline) == std::cv_status::no_timeout;
+		unpark();
+		return notified;
+	}
+
+	//Leave the parked consumers, a spurious or timed out wakeup may use up a notification
+	//meant for another consumer, which only means the next producer notifies once more
+	private: void unpark() {
+		waiting--;
+		if (wakeups > 0) wakeups--;
+	}
+};
@@ -1,39 +1,83 @@
+#pragma once
+
 /*
 Author: godraadam @ utcn 2019
-Description: basic, generic queue implementation using double linked list as container
+Description: basic, generic queue implementation using an unrolled linked list as container
+			 every node (chunk) holds up to chunk_size items, so an item costs a store and an index bump
+			 instead of a node allocation, and dequeuing walks memory sequentially
+			 drained chunks are kept in a small cache and reused instead of being freed
 Operations: enqueue() -> O(1)
+			emplace() -> O(1)
 			dequeue() -> O(1)
-			peek()	  -> O(1)
+			front()	  -> O(1)
+			end()	  -> O(1)
 			empty()   -> O(1)
 			size()    -> O(1)
 */
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
-template<class T>
+template<class T, size_t chunk_size = (sizeof(T) <= 8 ? 512 : sizeof(T) >= 64 ? 64 : 4096 / sizeof(T))>
 
 class queue final {
-	
-
-	//Helper class for linking items
-	private: class node {
-		public: T item;
-		public: node* next = nullptr;
-		public: node* prev = nullptr;
-		public: node(T item) {
-			this->item = item;
+
+	static_assert(chunk_size > 0, "Chunk size must be positive!");
+
+	//Helper class for linking blocks of items
+	private: class chunk final {
+		public: chunk* next = nullptr;
+
+		//Uninitialized storage for the items
+		private: alignas(T) unsigned char storage[chunk_size * sizeof(T)];
+
+		public: T* at(size_t index) {
+			return reinterpret_cast<T*>(storage) + index;
 		}
 	};
 
-	//Handle for the front of the queue
-	private: node* head = nullptr;
+	//Maximum number of drained chunks kept for reuse
+	private: static const size_t max_spare = 4;
+
+	//Chunk holding the front of the queue
+	private: chunk* head = nullptr;
+
+	//Chunk holding the end of the queue
+	private: chunk* tail = nullptr;
 
-	//Handle for the end of the queue
-	private: node* tail = nullptr;
+	//Index of the first item inside head
+	private: size_t _front = 0;
+
+	//Index after the last item inside tail
+	private: size_t _end = 0;
 
 	//Tracks the actual number of items in queue
 	private: size_t _size = 0;
 
+	//Drained chunks waiting to be reused
+	private: chunk* spare = nullptr;
+	private: size_t spare_count = 0;
+
+	//Default constructor
+	public: queue() {}
+
+	//Chunks are owned by the queue, copying it would free them twice
+	public: queue(const queue&) = delete;
+	public: queue& operator=(const queue&) = delete;
+
+	//Destructor, destroys the remaining items and releases every chunk
+	public: ~queue() {
+		while (!empty()) dequeue();
+		delete head;
+		while (spare != nullptr) {
+			chunk* c = spare;
+			spare = c->next;
+			delete c;
+		}
+	}
+
 	//Returns true only if queue is empty
 	public: bool empty() {
 		return _size == 0;
@@ -43,39 +87,92 @@ class queue final {
 	public: size_t size() {
 		return _size;
 	}
-	
+
 	//Returns the item at the front of the queueu i.e. the one that was inserted first
 	public: T front() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		return tail->item;
+		return *head->at(_front);
 	}
 
 	//Return the item at the end of the queue i.e. the one inserted last
 	public: T end() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		 return head->item;
+		return *tail->at(_end - 1);
 	}
 
 	//Adds an item to the end of the list
 	public: void enqueue(T item) {
-		node* p = new node(item);
-		if (empty()) head = tail = p;
-		else {
-			p->next = head;
-			head->prev = p;
-			head = p;
+		emplace(std::move(item));
+	}
+
+	//Construct an item at the end of the list from the given arguments
+	public: template<class... Args> void emplace(Args&&... args) {
+		if (tail == nullptr) head = tail = takeChunk();
+		else if (_end == chunk_size) {
+			chunk* c = takeChunk();
+			try {
+				new (c->at(0)) T(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				recycle(c);
+				throw;
+			}
+			tail->next = c;
+			tail = c;
+			_end = 1;
+			_size++;
+			return;
 		}
+		new (tail->at(_end)) T(std::forward<Args>(args)...);
+		_end++;
 		_size++;
 	}
 
 	//Removes the item from the front of the queue and returns it
 	public: T dequeue() {
 		if (empty()) throw std::length_error("Queue is empty!");
-		T ret = tail->item;
-		node* p = tail;
-		tail = p->prev;
-		delete p;
+		T* item = head->at(_front);
+		T ret = std::move(*item);
+		item->~T();
+		_front++;
 		_size--;
+
+		if (_front == chunk_size) {
+			//Front chunk drained, move on to the next one
+			chunk* c = head;
+			head = head->next;
+			recycle(c);
+			_front = 0;
+			if (head == nullptr) {
+				tail = nullptr;
+				_end = 0;
+			}
+		}
+		//Last chunk drained part way, start over from its beginning
+		else if (empty()) _front = _end = 0;
 		return ret;
 	}
-};
\ No newline at end of file
+
+	//Helpers______________________________________
+
+	//Returns an empty chunk, reusing a spare one if possible
+	private: chunk* takeChunk() {
+		if (spare == nullptr) return new chunk;
+		chunk* c = spare;
+		spare = c->next;
+		spare_count--;
+		c->next = nullptr;
+		return c;
+	}
+
+	//Keep a drained chunk for reuse, or free it if the cache is full
+	private: void recycle(chunk* c) {
+		if (spare_count == max_spare) {
+			delete c;
+			return;
+		}
+		c->next = spare;
+		spare = c;
+		spare_count++;
+	}
+};
@@ -0,0 +1,206 @@
+/*
+Author: godraadam @ utcn 2019
+Description: lock-free, generic bounded multi-producer/multi-consumer queue using a circular array as container
+			 every slot carries a sequence number telling which lap of the ring it is ready for (Vyukov),
+			 so producers and consumers only contend on their own position counter and never on each other
+			 safe to use from any number of threads
+Operations: try_enqueue()  -> O(1)
+			enqueue_bulk() -> O(k)
+			try_dequeue()  -> O(1)
+			dequeue_bulk() -> O(k)
+			empty()		   -> O(1) (approximate while other threads are modifying the queue)
+			size()		   -> O(1) (approximate while other threads are modifying the queue)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+
+class mpmcQueue final {
+
+	//Size of a cache line, fields written by different threads are kept this far apart
+	private: static const size_t cache_line = 64;
+
+	//Slot of the ring, sequence == position means free for that position, position + 1 means filled
+	private: struct slot {
+		std::atomic<size_t> sequence;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* item() {
+			return std::launder(reinterpret_cast<T*>(storage));
+		}
+	};
+
+	//Fields_______________________________________
+
+	//Number of slots, always a power of two
+	private: size_t _capacity;
+
+	//Bitmask mapping a position to its slot
+	private: size_t mask;
+
+	//Actual container to store the items
+	private: slot* _queue;
+
+	//Next position to be claimed by a producer
+	private: alignas(cache_line) std::atomic<size_t> _end{ 0 };
+
+	//Next position to be claimed by a consumer
+	private: alignas(cache_line) std::atomic<size_t> _front{ 0 };
+
+	//Keeps the consumer position from sharing a line with whatever follows the queue
+	private: char padding[cache_line - sizeof(std::atomic<size_t>)];
+
+	//Methods______________________________________
+
+	//Constructor with custom capacity, rounded up to a power of two
+	public: mpmcQueue(size_t capacity = 1024) {
+		if (capacity < 2 || capacity > (SIZE_MAX >> 1) + 1) throw std::length_error("Invalid size!");
+		_capacity = 1;
+		while (_capacity < capacity) _capacity <<= 1;
+		mask = _capacity - 1;
+		_queue = new slot[_capacity];
+		for (size_t i = 0; i < _capacity; i++) _queue[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	public: mpmcQueue(const mpmcQueue&) = delete;
+	public: mpmcQueue& operator=(const mpmcQueue&) = delete;
+
+	//Destructor, must not run concurrently with any other operation on the queue
+	public: ~mpmcQueue() {
+		size_t end = _end.load(std::memory_order_acquire);
+		for (size_t i = _front.load(std::memory_order_acquire); i != end; i++) _queue[i & mask].item()->~T();
+		delete[] _queue;
+	}
+
+	//Add item to the end of the queue, returns false if the queue is full
+	//The item is moved in after its slot is claimed, a move that throws would leave the slot claimed but never published
+	public: bool try_enqueue(T item) {
+		static_assert(std::is_nothrow_move_constructible<T>::value, "try_enqueue() needs items that move without throwing!");
+		size_t pos = _end.load(std::memory_order_relaxed);
+		slot* s;
+		while (true) {
+			s = &_queue[pos & mask];
+			intptr_t diff = (intptr_t)s->sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+			if (diff == 0) {
+				if (_end.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0) return false;
+			else pos = _end.load(std::memory_order_relaxed);
+		}
+		new (s->storage) T(std::move(item));
+		s->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Construct item at the end of the queue, returns false if the queue is full
+	//The item is built before a slot is claimed, so a constructor that throws leaves the queue untouched
+	public: template<class... Args> bool try_emplace(Args&&... args) {
+		return try_enqueue(T(std::forward<Args>(args)...));
+	}
+
+	//Move up to count items from the given array to the end of the queue
+	//Claims a run of consecutive free slots with a single update of the producer position
+	//Returns the number of items added
+	//A move that throws halfway would leave part of the batch claimed but never published
+	public: size_t enqueue_bulk(T* items, size_t count) {
+		static_assert(std::is_nothrow_move_constructible<T>::value, "enqueue_bulk() needs items that move without throwing!");
+		if (count == 0) return 0;
+		size_t pos = _end.load(std::memory_order_relaxed);
+		size_t claimed;
+		while (true) {
+			claimed = 0;
+			while (claimed < count && claimed < _capacity &&
+				_queue[(pos + claimed) & mask].sequence.load(std::memory_order_acquire) == pos + claimed) claimed++;
+
+			if (claimed == 0) {
+				intptr_t diff = (intptr_t)_queue[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+				if (diff < 0) return 0;
+				pos = _end.load(std::memory_order_relaxed);
+			}
+			else if (_end.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			slot& s = _queue[(pos + i) & mask];
+			new (s.storage) T(std::move(items[i]));
+			s.sequence.store(pos + i + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	//Remove the item at the front of the queue into item, returns false if the queue is empty
+	//A move that throws would leave the slot claimed but never handed back
+	public: bool try_dequeue(T& item) {
+		static_assert(std::is_nothrow_move_assignable<T>::value, "try_dequeue() needs items that move without throwing!");
+		size_t pos = _front.load(std::memory_order_relaxed);
+		slot* s;
+		while (true) {
+			s = &_queue[pos & mask];
+			intptr_t diff = (intptr_t)s->sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+			if (diff == 0) {
+				if (_front.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0) return false;
+			else pos = _front.load(std::memory_order_relaxed);
+		}
+		T* p = s->item();
+		item = std::move(*p);
+		p->~T();
+		s->sequence.store(pos + _capacity, std::memory_order_release);
+		return true;
+	}
+
+	//Move up to count items from the front of the queue to the given array
+	//Claims a run of consecutive filled slots with a single update of the consumer position
+	//Returns the number of items removed
+	//A move that throws halfway would leave part of the batch claimed but never handed back
+	public: size_t dequeue_bulk(T* items, size_t count) {
+		static_assert(std::is_nothrow_move_assignable<T>::value, "dequeue_bulk() needs items that move without throwing!");
+		if (count == 0) return 0;
+		size_t pos = _front.load(std::memory_order_relaxed);
+		size_t claimed;
+		while (true) {
+			claimed = 0;
+			while (claimed < count && claimed < _capacity &&
+				_queue[(pos + claimed) & mask].sequence.load(std::memory_order_acquire) == pos + claimed + 1) claimed++;
+
+			if (claimed == 0) {
+				intptr_t diff = (intptr_t)_queue[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+				if (diff < 0) return 0;
+				pos = _front.load(std::memory_order_relaxed);
+			}
+			else if (_front.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+		}
+		for (size_t i = 0; i < claimed; i++) {
+			slot& s = _queue[(pos + i) & mask];
+			T* p = s.item();
+			items[i] = std::move(*p);
+			p->~T();
+			s.sequence.store(pos + i + _capacity, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	//Returns true only if queue is empty
+	public: bool empty() {
+		return size() == 0;
+	}
+
+	//Returns current number of items in queue
+	public: size_t size() {
+		size_t front = _front.load(std::memory_order_acquire);
+		size_t end = _end.load(std::memory_order_acquire);
+		return end > front ? end - front : 0;
+	}
+
+	//Returns maximum number of items the queue can hold
+	public: size_t capacity() {
+		return _capacity;
+	}
+};
@@ -0,0 +1,68 @@
+/*
+Author: godraadam @ utcn 2019
+Description: scaling benchmark of the multi-producer/multi-consumer queue, from 1 to N producer and consumer threads
+Build: g++ -O2 -std=c++17 -pthread queue_mpmc_bench.cpp -o queue_mpmc_bench
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "queue_mpmc.cpp"
+
+//Run the given number of producers and as many consumers moving items through the queue, in batches if batch > 1
+//Returns millions of items per second
+static double throughput(size_t threads, size_t items_per_producer, size_t batch) {
+	mpmcQueue<size_t> q(8192);
+	std::atomic<size_t> sum{ 0 };
+	std::vector<std::thread> workers;
+	size_t total = threads * items_per_producer;
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&q, items_per_producer, batch] {
+			std::vector<size_t> buffer(batch);
+			for (size_t sent = 0; sent < items_per_producer;) {
+				size_t count = items_per_producer - sent < batch ? items_per_producer - sent : batch;
+				for (size_t i = 0; i < count; i++) buffer[i] = sent + i;
+				size_t done = 0;
+				while (done < count) {
+					size_t n = batch == 1 ? (q.try_enqueue(buffer[0]) ? 1 : 0) : q.enqueue_bulk(buffer.data() + done, count - done);
+					if (n == 0) std::this_thread::yield();
+					done += n;
+				}
+				sent += count;
+			}
+		});
+		workers.emplace_back([&q, &sum, items_per_producer, batch] {
+			std::vector<size_t> buffer(batch);
+			size_t local = 0;
+			for (size_t received = 0; received < items_per_producer;) {
+				size_t want = items_per_producer - received < batch ? items_per_producer - received : batch;
+				size_t n = batch == 1 ? (q.try_dequeue(buffer[0]) ? 1 : 0) : q.dequeue_bulk(buffer.data(), want);
+				if (n == 0) std::this_thread::yield();
+				for (size_t i = 0; i < n; i++) local += buffer[i];
+				received += n;
+			}
+			sum += local;
+		});
+	}
+	for (std::thread& w : workers) w.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (sum != threads * (items_per_producer * (items_per_producer - 1) / 2)) std::printf("checksum mismatch!\n");
+	return total / seconds / 1e6;
+}
+
+int main() {
+	const size_t items = 2000000;
+	size_t max_threads = std::thread::hardware_concurrency();
+	if (max_threads < 2) max_threads = 2;
+
+	std::printf("%22s %16s %16s\n", "producers/consumers", "single (Mitems/s)", "bulk 32 (Mitems/s)");
+	for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+		std::printf("%22zu %16.2f %16.2f\n", threads, throughput(threads, items, 1), throughput(threads, items, 32));
+	}
+	return 0;
+}
@@ -0,0 +1,180 @@
+/*
+Author: godraadam @ utcn 2019
+Description: lock-free, generic single-producer/single-consumer queue using a circular array as container
+			 exactly one thread may add items and exactly one other thread may remove them
+			 the producer and consumer indices live on separate cache lines and each side keeps a local copy
+			 of the other side's index, so the shared index is only read again when the cached one runs out
+Operations: try_enqueue()  -> O(1)
+			enqueue()	   -> O(1)
+			enqueue_bulk() -> O(k)
+			try_dequeue()  -> O(1)
+			dequeue()	   -> O(1)
+			dequeue_bulk() -> O(k)
+			empty()		   -> O(1) (approximate while the other side is active)
+			size()		   -> O(1) (approximate while the other side is active)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+
+class spscQueue final {
+
+	//Size of a cache line, fields written by different threads are kept this far apart
+	private: static const size_t cache_line = 64;
+
+	//Fields_______________________________________
+
+	//Number of slots, always a power of two
+	private: size_t _capacity;
+
+	//Bitmask mapping a position to its slot
+	private: size_t mask;
+
+	//Actual container to store the items
+	private: T* _queue;
+
+	//Position after the last item, written by the producer only
+	private: alignas(cache_line) std::atomic<size_t> _end{ 0 };
+
+	//Producer's copy of the consumer position, may lag behind it
+	private: size_t front_cache = 0;
+
+	//Position of the first item, written by the consumer only
+	private: alignas(cache_line) std::atomic<size_t> _front{ 0 };
+
+	//Consumer's copy of the producer position, may lag behind it
+	private: size_t end_cache = 0;
+
+	//Keeps the consumer fields from sharing a line with whatever follows the queue
+	private: char padding[cache_line - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+	//Methods______________________________________
+
+	//Constructor with custom capacity, rounded up to a power of two
+	public: spscQueue(size_t capacity = 1024) {
+		if (capacity == 0 || capacity > (SIZE_MAX >> 1) + 1) throw std::length_error("Invalid size!");
+		_capacity = 1;
+		while (_capacity < capacity) _capacity <<= 1;
+		mask = _capacity - 1;
+		_queue = std::allocator<T>().allocate(_capacity);
+	}
+
+	public: spscQueue(const spscQueue&) = delete;
+	public: spscQueue& operator=(const spscQueue&) = delete;
+
+	//Destructor, must not run concurrently with the producer or the consumer
+	public: ~spscQueue() {
+		size_t end = _end.load(std::memory_order_acquire);
+		for (size_t i = _front.load(std::memory_order_acquire); i != end; i++) _queue[i & mask].~T();
+		std::allocator<T>().deallocate(_queue, _capacity);
+	}
+
+	//Producer: add item to the end of the queue, returns false if the queue is full
+	public: bool try_enqueue(T item) {
+		return try_emplace(std::move(item));
+	}
+
+	//Producer: construct item at the end of the queue, returns false if the queue is full
+	public: template<class... Args> bool try_emplace(Args&&... args) {
+		size_t end = _end.load(std::memory_order_relaxed);
+		if (end - front_cache == _capacity) {
+			front_cache = _front.load(std::memory_order_acquire);
+			if (end - front_cache == _capacity) return false;
+		}
+		new (_queue + (end & mask)) T(std::forward<Args>(args)...);
+		_end.store(end + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Producer: add item to the end of the queue
+	public: void enqueue(T item) {
+		if (!try_emplace(std::move(item))) throw std::length_error("Queue is full!");
+	}
+
+	//Producer: move up to count items from the given array to the end of the queue
+	//The consumer sees the whole batch at once, returns the number of items added
+	//A move that throws halfway would leave part of the batch claimed but never published
+	public: size_t enqueue_bulk(T* items, size_t count) {
+		static_assert(std::is_nothrow_move_constructible<T>::value, "enqueue_bulk() needs items that move without throwing!");
+		size_t end = _end.load(std::memory_order_relaxed);
+		size_t free = _capacity - (end - front_cache);
+		if (free < count) {
+			front_cache = _front.load(std::memory_order_acquire);
+			free = _capacity - (end - front_cache);
+		}
+		if (count > free) count = free;
+		for (size_t i = 0; i < count; i++) new (_queue + ((end + i) & mask)) T(std::move(items[i]));
+		_end.store(end + count, std::memory_order_release);
+		return count;
+	}
+
+	//Consumer: remove the item at the front of the queue into item, returns false if the queue is empty
+	public: bool try_dequeue(T& item) {
+		size_t front = _front.load(std::memory_order_relaxed);
+		if (front == end_cache) {
+			end_cache = _end.load(std::memory_order_acquire);
+			if (front == end_cache) return false;
+		}
+		T& slot = _queue[front & mask];
+		item = std::move(slot);
+		slot.~T();
+		_front.store(front + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Consumer: remove the item at the front of the queue and return it
+	public: T dequeue() {
+		size_t front = _front.load(std::memory_order_relaxed);
+		if (front == end_cache) {
+			end_cache = _end.load(std::memory_order_acquire);
+			if (front == end_cache) throw std::length_error("Queue is empty!");
+		}
+		T& slot = _queue[front & mask];
+		T ret = std::move(slot);
+		slot.~T();
+		_front.store(front + 1, std::memory_order_release);
+		return ret;
+	}
+
+	//Consumer: move up to count items from the front of the queue to the given array
+	//The slots are handed back to the producer at once, returns the number of items removed
+	//A move that throws halfway would leave part of the batch claimed but never handed back
+	public: size_t dequeue_bulk(T* items, size_t count) {
+		static_assert(std::is_nothrow_move_assignable<T>::value, "dequeue_bulk() needs items that move without throwing!");
+		size_t front = _front.load(std::memory_order_relaxed);
+		if (end_cache - front < count) end_cache = _end.load(std::memory_order_acquire);
+		size_t available = end_cache - front;
+		if (count > available) count = available;
+		for (size_t i = 0; i < count; i++) {
+			T& slot = _queue[(front + i) & mask];
+			items[i] = std::move(slot);
+			slot.~T();
+		}
+		_front.store(front + count, std::memory_order_release);
+		return count;
+	}
+
+	//Returns true only if queue is empty
+	public: bool empty() {
+		return size() == 0;
+	}
+
+	//Returns current number of items in queue
+	public: size_t size() {
+		size_t front = _front.load(std::memory_order_acquire);
+		return _end.load(std::memory_order_acquire) - front;
+	}
+
+	//Returns maximum number of items the queue can hold
+	public: size_t capacity() {
+		return _capacity;
+	}
+};
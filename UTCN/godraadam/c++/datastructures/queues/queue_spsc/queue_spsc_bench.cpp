@@ -0,0 +1,134 @@
+/*
+Author: godraadam @ utcn 2019
+Description: ping-pong latency and producer/consumer throughput benchmarks of the single-producer/single-consumer queue
+			 the throughput benchmark also runs the array queue guarded by a mutex for reference
+Build: g++ -O2 -std=c++17 -pthread queue_spsc_bench.cpp -o queue_spsc_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include "queue_spsc.cpp"
+#include "../queue_array/queue_array.cpp"
+
+//The array queue with every operation serialized by a single lock
+template <class T>
+
+class mutexQueue final {
+
+	private: queue<T> _queue;
+	private: std::mutex lock;
+
+	public: mutexQueue(size_t capacity) : _queue(capacity) {}
+
+	public: bool try_enqueue(T item) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (_queue.full()) return false;
+		_queue.enqueue(item);
+		return true;
+	}
+
+	public: bool try_dequeue(T& item) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (_queue.empty()) return false;
+		item = _queue.dequeue();
+		return true;
+	}
+};
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Two threads bounce a token through a pair of queues, returns the mean round trip in nanoseconds
+static double pingPong(size_t rounds) {
+	spscQueue<size_t> ping(64), pong(64);
+
+	std::thread echo([&] {
+		size_t token;
+		for (size_t i = 0; i < rounds; i++) {
+			while (!ping.try_dequeue(token)) std::this_thread::yield();
+			while (!pong.try_enqueue(token)) std::this_thread::yield();
+		}
+	});
+
+	auto start = std::chrono::steady_clock::now();
+	size_t token;
+	for (size_t i = 0; i < rounds; i++) {
+		while (!ping.try_enqueue(i)) std::this_thread::yield();
+		while (!pong.try_dequeue(token)) std::this_thread::yield();
+	}
+	double elapsed = seconds(start);
+	echo.join();
+	return elapsed / rounds * 1e9;
+}
+
+//One producer streams items to one consumer one at a time, returns millions of items per second
+template <class Q>
+static double throughput(size_t items) {
+	Q q(4096);
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&] {
+		for (size_t i = 0; i < items; i++)
+			while (!q.try_enqueue(i)) std::this_thread::yield();
+	});
+
+	size_t item, sum = 0;
+	for (size_t i = 0; i < items; i++) {
+		while (!q.try_dequeue(item)) std::this_thread::yield();
+		sum += item;
+	}
+	producer.join();
+	if (sum != items * (items - 1) / 2) std::printf("checksum mismatch!\n");
+	return items / seconds(start) / 1e6;
+}
+
+//One producer streams items to one consumer in batches, returns millions of items per second
+static double bulkThroughput(size_t items, size_t batch) {
+	spscQueue<size_t> q(4096);
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&] {
+		size_t* buffer = new size_t[batch];
+		for (size_t sent = 0; sent < items;) {
+			size_t count = items - sent < batch ? items - sent : batch;
+			for (size_t i = 0; i < count; i++) buffer[i] = sent + i;
+			size_t done = 0;
+			while (done < count) {
+				size_t n = q.enqueue_bulk(buffer + done, count - done);
+				if (n == 0) std::this_thread::yield();
+				done += n;
+			}
+			sent += count;
+		}
+		delete[] buffer;
+	});
+
+	size_t* buffer = new size_t[batch];
+	size_t sum = 0;
+	for (size_t received = 0; received < items;) {
+		size_t n = q.dequeue_bulk(buffer, batch);
+		if (n == 0) std::this_thread::yield();
+		for (size_t i = 0; i < n; i++) sum += buffer[i];
+		received += n;
+	}
+	producer.join();
+	delete[] buffer;
+	if (sum != items * (items - 1) / 2) std::printf("checksum mismatch!\n");
+	return items / seconds(start) / 1e6;
+}
+
+int main() {
+	const size_t items = 20000000;
+
+	std::printf("ping-pong round trip: %.1f ns\n\n", pingPong(200000));
+
+	std::printf("%-32s %12s\n", "throughput", "Mitems/s");
+	std::printf("%-32s %12.2f\n", "mutex + array queue", throughput<mutexQueue<size_t>>(items));
+	std::printf("%-32s %12.2f\n", "spsc, single items", throughput<spscQueue<size_t>>(items));
+	std::printf("%-32s %12.2f\n", "spsc, batches of 64", bulkThroughput(items, 64));
+	std::printf("%-32s %12.2f\n", "spsc, batches of 512", bulkThroughput(items, 512));
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*
+Author: godraadam @ utcn 2019
+Description: lock-free work-stealing deque (Chase-Lev) using a growable circular array as container
+			 the owning thread pushes and pops at the bottom (LIFO), any other thread steals from the top (FIFO)
+			 only a steal racing the owner for the very last item needs a compare-and-swap
+			 items are read by thieves before they know whether they won them, so T must be trivially
+			 copyable, typically a pointer to a task
+			 replaced arrays are kept until the deque is destroyed, a slow thief may still be reading them
+Operations: push()		-> O(1) (amortized time, owner only)
+			try_pop()	-> O(1) (owner only)
+			try_steal()	-> O(1) (any thread)
+			empty()		-> O(1) (approximate while other threads are modifying the deque)
+			size()		-> O(1) (approximate while other threads are modifying the deque)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+template <class T>
+
+class workStealingDeque final {
+
+	static_assert(std::is_trivially_copyable<T>::value, "Items of a work-stealing deque must be trivially copyable!");
+
+	//Size of a cache line, fields written by different threads are kept this far apart
+	private: static const size_t cache_line = 64;
+
+	//Circular array of atomic slots, positions are mapped to slots with a bitmask
+	private: class ring final {
+		public: int64_t capacity;
+		public: int64_t mask;
+		public: std::atomic<T>* slots;
+
+		//Ring replaced by this one, freed together with it
+		public: ring* previous = nullptr;
+
+		public: ring(int64_t capacity) : capacity(capacity), mask(capacity - 1) {
+			slots = new std::atomic<T>[capacity];
+		}
+
+		public: ~ring() {
+			delete[] slots;
+		}
+
+		public: T get(int64_t index) {
+			return slots[index & mask].load(std::memory_order_relaxed);
+		}
+
+		public: void put(int64_t index, T item) {
+			slots[index & mask].store(item, std::memory_order_relaxed);
+		}
+
+		//Returns a ring twice as large holding the items between top and bottom
+		public: ring* grow(int64_t top, int64_t bottom) {
+			ring* r = new ring(capacity * 2);
+			for (int64_t i = top; i < bottom; i++) r->put(i, get(i));
+			r->previous = this;
+			return r;
+		}
+	};
+
+	//Fields_______________________________________
+
+	//Position of the oldest item, advanced by thieves and by the owner taking the last item
+	private: alignas(cache_line) std::atomic<int64_t> top{ 0 };
+
+	//Position after the newest item, written by the owner only
+	private: alignas(cache_line) std::atomic<int64_t> bottom{ 0 };
+
+	//Current array
+	private: alignas(cache_line) std::atomic<ring*> array;
+
+	//Methods______________________________________
+
+	//Constructor with custom initial capacity, rounded up to a power of two
+	public: workStealingDeque(size_t capacity = 256) {
+		if (capacity == 0 || capacity > (size_t)INT64_MAX / 2) throw std::length_error("Invalid size!");
+		int64_t size = 1;
+		while ((size_t)size < capacity) size <<= 1;
+		array.store(new ring(size), std::memory_order_relaxed);
+	}
+
+	public: workStealingDeque(const workStealingDeque&) = delete;
+	public: workStealingDeque& operator=(const workStealingDeque&) = delete;
+
+	//Destructor, must not run concurrently with any other operation on the deque
+	public: ~workStealingDeque() {
+		ring* r = array.load(std::memory_order_relaxed);
+		while (r != nullptr) {
+			ring* previous = r->previous;
+			delete r;
+			r = previous;
+		}
+	}
+
+	//Owner: add item at the bottom of the deque
+	public: void push(T item) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		ring* r = array.load(std::memory_order_relaxed);
+		if (b - t > r->capacity - 1) {
+			r = r->grow(t, b);
+			array.store(r, std::memory_order_release);
+		}
+		r->put(b, item);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	//Owner: remove the newest item into item, returns false if the deque is empty
+	public: bool try_pop(T& item) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		ring* r = array.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		item = r->get(b);
+		if (t < b) return true;
+
+		//Last item, race the thieves for it
+		bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	//Thief: remove the oldest item into item, returns false if the deque is empty or another thread got it first
+	public: bool try_steal(T& item) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b) return false;
+
+		ring* r = array.load(std::memory_order_acquire);
+		item = r->get(t);
+		return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	//Returns true only if deque is empty
+	public: bool empty() {
+		return size() == 0;
+	}
+
+	//Returns current number of items in deque
+	public: size_t size() {
+		int64_t t = top.load(std::memory_order_acquire);
+		int64_t b = bottom.load(std::memory_order_acquire);
+		return b > t ? (size_t)(b - t) : 0;
+	}
+};
@@ -0,0 +1,86 @@
+/*
+Author: godraadam @ utcn 2019
+Description: recursive task benchmark of the work-stealing thread pool, parallel fibonacci and binary tree sum
+			 from 1 worker up to one per hardware thread, speedup is relative to plain sequential recursion
+Build: g++ -O2 -std=c++17 -pthread queue_work_stealing_bench.cpp -o queue_work_stealing_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include "thread_pool.cpp"
+
+//Below this size subproblems are solved sequentially
+static const int cutoff = 18;
+
+static long fibSequential(int n) {
+	return n < 2 ? n : fibSequential(n - 1) + fibSequential(n - 2);
+}
+
+static long fib(threadPool& pool, int n) {
+	if (n < cutoff) return fibSequential(n);
+	long a, b;
+	threadPool::taskGroup group;
+	pool.spawn(group, [&] { a = fib(pool, n - 1); });
+	b = fib(pool, n - 2);
+	pool.wait(group);
+	return a + b;
+}
+
+//Sum of the values of a complete binary tree of given depth stored implicitly, node i has children 2i+1 and 2i+2
+static long treeSequential(long node, int depth) {
+	if (depth == 0) return node % 7;
+	return node % 7 + treeSequential(2 * node + 1, depth - 1) + treeSequential(2 * node + 2, depth - 1);
+}
+
+static long tree(threadPool& pool, long node, int depth) {
+	if (depth < cutoff) return treeSequential(node, depth);
+	long left, right;
+	threadPool::taskGroup group;
+	pool.spawn(group, [&] { left = tree(pool, 2 * node + 1, depth - 1); });
+	right = tree(pool, 2 * node + 2, depth - 1);
+	pool.wait(group);
+	return node % 7 + left + right;
+}
+
+//Returns the time it took to run f in milliseconds
+template<class F>
+static double measure(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Run the recursion as the root task of a pool with the given number of workers
+template<class F>
+static double parallel(size_t workers, F f) {
+	threadPool pool(workers);
+	return measure([&] {
+		threadPool::taskGroup group;
+		pool.spawn(group, [&] { f(pool); });
+		pool.wait(group);
+	});
+}
+
+int main() {
+	const int n = 38;
+	const int depth = 26;
+	size_t max_workers = std::thread::hardware_concurrency();
+	if (max_workers == 0) max_workers = 1;
+
+	long expected_fib = 0, expected_tree = 0, result = 0;
+	double fib_base = measure([&] { expected_fib = fibSequential(n); });
+	double tree_base = measure([&] { expected_tree = treeSequential(0, depth); });
+
+	std::printf("fib(%d) sequential: %.1f ms, tree sum(depth %d) sequential: %.1f ms\n\n", n, fib_base, depth, tree_base);
+	std::printf("%8s %12s %10s %12s %10s\n", "workers", "fib (ms)", "speedup", "tree (ms)", "speedup");
+	for (size_t workers = 1;; workers *= 2) {
+		if (workers > max_workers) workers = max_workers;
+		double fib_time = parallel(workers, [&](threadPool& pool) { result = fib(pool, n); });
+		if (result != expected_fib) std::printf("fib mismatch!\n");
+		double tree_time = parallel(workers, [&](threadPool& pool) { result = tree(pool, 0, depth); });
+		if (result != expected_tree) std::printf("tree sum mismatch!\n");
+		std::printf("%8zu %12.1f %10.2f %12.1f %10.2f\n", workers, fib_time, fib_base / fib_time, tree_time, tree_base / tree_time);
+		if (workers == max_workers) break;
+	}
+	return 0;
+}
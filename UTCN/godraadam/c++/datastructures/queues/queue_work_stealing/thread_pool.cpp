@@ -0,0 +1,237 @@
+/*
+Author: godraadam @ utcn 2019
+Description: fork/join thread pool built on the work-stealing deque
+			 every worker owns a deque, tasks spawned by a worker go to the bottom of its own deque and are
+			 run newest first, idle workers steal the oldest (largest) tasks from a random victim
+			 tasks spawned from outside the pool go through a shared queue guarded by a mutex
+			 a worker waiting for a task group keeps running other tasks until the group is done
+			 workers that find nothing to do sleep for at most a millisecond at a time
+Operations: spawn()	-> O(1) (amortized time)
+			submit()-> O(1) (amortized time)
+			wait()	-> blocks until every task spawned in the group has finished
+			size()	-> O(1)
+
+Example:	long fib(threadPool& pool, int n) {
+				if (n < 20) return fibSequential(n);
+				long a, b;
+				threadPool::taskGroup group;
+				pool.spawn(group, [&] { a = fib(pool, n - 1); });
+				b = fib(pool, n - 2);
+				pool.wait(group);
+				return a + b;
+			}
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "queue_work_stealing.cpp"
+#include "../queue_list/queue_list.cpp"
+
+class threadPool final {
+
+	//Tasks spawned into a group are counted until they finish
+	public: class taskGroup final {
+		friend class threadPool;
+
+		private: std::atomic<size_t> pending{ 0 };
+
+		public: taskGroup() {}
+		public: taskGroup(const taskGroup&) = delete;
+		public: taskGroup& operator=(const taskGroup&) = delete;
+	};
+
+	//Unit of work
+	private: class task {
+		public: taskGroup* group = nullptr;
+		public: virtual ~task() {}
+		public: virtual void run() = 0;
+	};
+
+	//Task running a callable
+	private: template<class F> class job final : public task {
+		private: F f;
+		public: job(F f) : f(std::move(f)) {}
+		public: void run() override {
+			f();
+		}
+	};
+
+	//Per-worker state, padded so neighbouring deques do not share cache lines
+	private: struct alignas(64) worker {
+		workStealingDeque<task*> deque;
+	};
+
+	//Fields_______________________________________
+
+	//Number of workers
+	private: size_t count;
+
+	private: worker* workers;
+	private: std::thread* threads;
+
+	//Tasks spawned from threads outside the pool
+	private: queue<task*> injected;
+	private: std::atomic<size_t> injected_count{ 0 };
+	private: std::mutex lock;
+
+	//Idle workers sleep here
+	private: std::condition_variable idle;
+	private: std::atomic<size_t> sleeping{ 0 };
+
+	private: std::atomic<bool> stopping{ false };
+
+	//Pool and index of the worker running on the calling thread, if any
+	private: inline static thread_local threadPool* current_pool = nullptr;
+	private: inline static thread_local size_t current_index = 0;
+
+	//Methods______________________________________
+
+	//Start the given number of workers, by default one per hardware thread
+	public: threadPool(size_t threads = std::thread::hardware_concurrency()) {
+		count = threads == 0 ? 1 : threads;
+		workers = new worker[count];
+		this->threads = new std::thread[count];
+		for (size_t i = 0; i < count; i++) this->threads[i] = std::thread([this, i] { work(i); });
+	}
+
+	public: threadPool(const threadPool&) = delete;
+	public: threadPool& operator=(const threadPool&) = delete;
+
+	//Stop the workers, tasks that have not started yet are discarded
+	public: ~threadPool() {
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+		}
+		idle.notify_all();
+		for (size_t i = 0; i < count; i++) threads[i].join();
+
+		task* t;
+		for (size_t i = 0; i < count; i++)
+			while (workers[i].deque.try_pop(t)) delete t;
+		while (!injected.empty()) delete injected.dequeue();
+		delete[] threads;
+		delete[] workers;
+	}
+
+	//Returns the number of workers
+	public: size_t size() {
+		return count;
+	}
+
+	//Run f on the pool without waiting for it
+	public: template<class F> void submit(F f) {
+		schedule(new job<F>(std::move(f)));
+	}
+
+	//Run f on the pool as part of the given group
+	public: template<class F> void spawn(taskGroup& group, F f) {
+		task* t = new job<F>(std::move(f));
+		t->group = &group;
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+		schedule(t);
+	}
+
+	//Block until every task of the group has finished
+	//A worker runs other tasks meanwhile, any other thread just waits
+	public: void wait(taskGroup& group) {
+		bool inside = current_pool == this;
+		size_t spins = 0;
+		while (group.pending.load(std::memory_order_acquire) != 0) {
+			task* t;
+			if (inside && findTask(current_index, t)) {
+				execute(t);
+				spins = 0;
+			}
+			else if (++spins < 64) std::this_thread::yield();
+			else std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+	//Helpers______________________________________
+
+	//Hand a new task to the pool
+	private: void schedule(task* t) {
+		if (current_pool == this) workers[current_index].deque.push(t);
+		else {
+			std::lock_guard<std::mutex> guard(lock);
+			injected.enqueue(t);
+			injected_count.fetch_add(1, std::memory_order_release);
+		}
+		if (sleeping.load(std::memory_order_relaxed) > 0) idle.notify_one();
+	}
+
+	//Run a task and report it finished to its group
+	private: void execute(task* t) {
+		t->run();
+		taskGroup* group = t->group;
+		delete t;
+		if (group != nullptr) group->pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	//Find a task for the given worker: its own newest task, then an injected one, then a stolen one
+	private: bool findTask(size_t index, task*& t) {
+		if (workers[index].deque.try_pop(t)) return true;
+
+		if (injected_count.load(std::memory_order_acquire) > 0) {
+			std::lock_guard<std::mutex> guard(lock);
+			if (!injected.empty()) {
+				t = injected.dequeue();
+				injected_count.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		size_t start = (size_t)(random() % count);
+		for (size_t i = 0; i < count; i++) {
+			size_t victim = (start + i) % count;
+			if (victim != index && workers[victim].deque.try_steal(t)) return true;
+		}
+		return false;
+	}
+
+	//Worker loop
+	private: void work(size_t index) {
+		current_pool = this;
+		current_index = index;
+		size_t spins = 0;
+		while (!stopping.load(std::memory_order_relaxed)) {
+			task* t;
+			if (findTask(index, t)) {
+				execute(t);
+				spins = 0;
+				continue;
+			}
+			if (++spins < 64) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			//Nothing to do for a while, sleep until notified, a task pushed to a deque without
+			//holding the lock may miss the notification, so the sleep is bounded
+			std::unique_lock<std::mutex> guard(lock);
+			sleeping.fetch_add(1, std::memory_order_relaxed);
+			if (!stopping.load(std::memory_order_relaxed) && injected.empty())
+				idle.wait_for(guard, std::chrono::milliseconds(1));
+			sleeping.fetch_sub(1, std::memory_order_relaxed);
+			spins = 0;
+		}
+		current_pool = nullptr;
+	}
+
+	//Per-thread xorshift generator for picking victims
+	private: static uint64_t random() {
+		static thread_local uint64_t state = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+};
@@ -1,45 +1,80 @@
 /*
 Author: godraadam @ utcn 2019
-Description: basic, generic stack implementation using array as container
+Description: basic, generic stack implementation using a segmented array as container
+			 the container grows one fixed-size segment at a time, so items are never copied
+			 when the stack grows and their addresses stay stable while they are on the stack
+			 segments are uninitialized memory, items are constructed in place and destroyed when popped
 Operations: pop()  -> O(1)
-			push() -> O(1) 
+			push() -> O(1)
+			emplace() -> O(1)
 			peek() -> O(1)
 			empty()-> O(1)
 			full() -> O(1)
 			size() -> O(1)
+			trim() -> O(number of idle segments)
 */
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
-template<class T>
+template<class T, size_t segment_size = (sizeof(T) < 4096 ? 4096 / sizeof(T) : 1)>
 
 class stack final {
 
+	static_assert(segment_size > 0, "Segment size must be positive!");
+
 	//Fields_______________________________________
 
-	//Maximum number of elements this stack can hold
-	private: size_t max_size = UINT16_MAX; //should be enough for most purposes, more could take up too much memory on stack
+	//Maximum number of elements this stack can hold, unbounded by default
+	private: size_t max_size = SIZE_MAX;
 
-	//Pointer to the top of the stack
+	//Current number of items on the stack
 	private: size_t head = 0;
 
-	//Container to actually store the items
-	private: T* _stack;
+	//Directory of segments, only this array of pointers is ever reallocated
+	private: T** segments = nullptr;
+
+	//Number of slots in the segment directory
+	private: size_t directory_size = 0;
+
+	//Number of segments allocated, always the first ones in the directory
+	private: size_t allocated = 0;
+
+	//Number of segments holding items, the last one of them contains the top of the stack
+	private: size_t used = 0;
+
+	//Start, next free slot and end of the segment containing the top of the stack
+	private: T* top_begin = nullptr;
+	private: T* top = nullptr;
+	private: T* top_end = nullptr;
 
 	//Methods______________________________________
 
-	//Default constructor
-	public: stack() {
-		_stack = new T[max_size];
-	}
-	
-	//Constructor with custom maximum size, practical to save memory for smaller scope purposes
+	//Default constructor, no memory is allocated until the first push
+	public: stack() {}
+
+	//Constructor with custom maximum size
 	public: stack(size_t max_size) {
-		if (max_size > this->max_size) throw std::bad_array_new_length("Stack size too large!");
 		this->max_size = max_size;
-		_stack = new T[max_size];
 	}
-	
+
+	//Segments are owned by the stack, copying it would free them twice
+	public: stack(const stack&) = delete;
+	public: stack& operator=(const stack&) = delete;
+
+	//Destructor, destroys the remaining items and releases every segment
+	public: ~stack() {
+		for (size_t i = 0; i + 1 < used; i++)
+			for (T* p = segments[i]; p != segments[i] + segment_size; p++) p->~T();
+		for (T* p = top_begin; p != top; p++) p->~T();
+		for (size_t i = 0; i < allocated; i++) release(segments[i]);
+		delete[] segments;
+	}
+
 	//Returns true only if stack is empty
 	public: bool empty() {
 		return head == 0;
@@ -48,33 +83,102 @@ class stack final {
 	//Returns true only if stack is full
 	public: bool full() {
 		return head == max_size;
-}
+	}
 
 	//Push item on top of stack
 	public: void push(T item) {
+		emplace(std::move(item));
+	}
+
+	//Construct item on top of stack from the given arguments
+	public: template<class... Args> void emplace(Args&&... args) {
 		if (full()) throw std::length_error("Stack is full!");
-		_stack[head++] = item;
+		if (top == top_end) nextSegment();
+		try {
+			new (top) T(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			//Step back if a fresh segment was entered for nothing
+			if (top == top_begin && used > 1) prevSegment();
+			throw;
+		}
+		top++;
+		head++;
 	}
 
 	//Pop item from top of stack and return it
 	public: T pop() {
 		if (empty()) throw std::length_error("Stack is empty!");
-		return _stack[head--];
+		T ret = std::move(*--top);
+		top->~T();
+		head--;
+		if (top == top_begin && used > 1) prevSegment();
+		return ret;
 	}
 
 	//Return item on top of stack, without removing it
 	public: T peek() {
 		if (empty()) throw std::length_error("Stack is empty!");
-		return _stack[head - 1];
+		return *(top - 1);
 	}
 
 	//Returns current number of items in the stack
 	public: size_t size() {
 		return head;
 	}
-	
+
 	//Return total number of items this stack can hold
 	public: size_t maxSize() {
 		return this->max_size;
 	}
+
+	//Returns the number of items the currently allocated segments can hold
+	public: size_t capacity() {
+		return allocated * segment_size;
+	}
+
+	//Release every segment not holding any items
+	public: void trim() {
+		if (empty() && used > 0) {
+			used = 0;
+			top_begin = top = top_end = nullptr;
+		}
+		while (allocated > used) release(segments[--allocated]);
+	}
+
+	//Helpers______________________________________
+
+	//Move the top of the stack to the start of the next segment, allocating it if needed
+	private: void nextSegment() {
+		if (used == allocated) {
+			if (allocated == directory_size) growDirectory();
+			segments[allocated++] = std::allocator<T>().allocate(segment_size);
+		}
+		top_begin = top = segments[used++];
+		top_end = top + segment_size;
+	}
+
+	//Move the top of the stack to the end of the previous segment
+	//One idle segment is kept to avoid reallocating when pushing and popping around a boundary
+	private: void prevSegment() {
+		used--;
+		while (allocated > used + 1) release(segments[--allocated]);
+		top_begin = segments[used - 1];
+		top = top_end = top_begin + segment_size;
+	}
+
+	//Give the memory of a segment holding no items back
+	private: void release(T* segment) {
+		std::allocator<T>().deallocate(segment, segment_size);
+	}
+
+	//Double the number of slots in the segment directory
+	private: void growDirectory() {
+		size_t new_size = directory_size == 0 ? 8 : directory_size * 2;
+		T** tmp = new T*[new_size];
+		for (size_t i = 0; i < allocated; i++) tmp[i] = segments[i];
+		delete[] segments;
+		segments = tmp;
+		directory_size = new_size;
+	}
 };
\ No newline at end of file
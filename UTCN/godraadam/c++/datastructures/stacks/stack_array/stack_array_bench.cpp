@@ -0,0 +1,91 @@
+/*
+Author: godraadam @ utcn 2019
+Description: benchmark of the segmented array stack against the previous fixed array stack
+Build: g++ -O2 -std=c++17 stack_array_bench.cpp -o stack_array_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "stack_array.cpp"
+
+//The previous container, one array of UINT16_MAX items allocated up front
+template<class T>
+
+class fixedStack final {
+
+	private: size_t max_size = UINT16_MAX;
+	private: size_t head = 0;
+	private: T* _stack;
+
+	public: fixedStack() {
+		_stack = new T[max_size];
+	}
+
+	public: ~fixedStack() {
+		delete[] _stack;
+	}
+
+	public: void push(T item) {
+		if (head == max_size) throw std::length_error("Stack is full!");
+		_stack[head++] = item;
+	}
+
+	public: T pop() {
+		if (head == 0) throw std::length_error("Stack is empty!");
+		return _stack[--head];
+	}
+};
+
+//Returns the time it took to run f in milliseconds
+template<class F>
+static double measure(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Construct and destroy empty stacks
+template<class S>
+static double emptyStacks(size_t rounds) {
+	return measure([&] {
+		for (size_t i = 0; i < rounds; i++) {
+			S s;
+			(void)s;
+		}
+	});
+}
+
+//Fill the stack up to depth and drain it again, repeated a number of rounds
+template<class S>
+static double pushPop(size_t depth, size_t rounds, long long& sink) {
+	return measure([&] {
+		S s;
+		for (size_t r = 0; r < rounds; r++) {
+			for (size_t i = 0; i < depth; i++) s.push((int)i);
+			for (size_t i = 0; i < depth; i++) sink += s.pop();
+		}
+	});
+}
+
+int main() {
+	long long sink = 0;
+
+	std::printf("%-40s %12s %12s\n", "workload", "fixed (ms)", "segmented (ms)");
+
+	std::printf("%-40s %12.2f %12.2f\n", "1000 empty stacks of std::string",
+		emptyStacks<fixedStack<std::string>>(1000), emptyStacks<stack<std::string>>(1000));
+
+	std::printf("%-40s %12.2f %12.2f\n", "push/pop 60000 ints x 500",
+		pushPop<fixedStack<int>>(60000, 500, sink), pushPop<stack<int>>(60000, 500, sink));
+
+	std::printf("%-40s %12.2f %12.2f\n", "push/pop 64 ints x 500000",
+		pushPop<fixedStack<int>>(64, 500000, sink), pushPop<stack<int>>(64, 500000, sink));
+
+	//The fixed stack can not go deeper than UINT16_MAX items
+	std::printf("%-40s %12s %12.2f\n", "push/pop 50000000 ints x 1",
+		"n/a", pushPop<stack<int>>(50000000, 1, sink));
+
+	std::printf("checksum: %lld\n", sink);
+	return 0;
+}
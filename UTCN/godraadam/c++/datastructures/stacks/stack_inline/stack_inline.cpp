@@ -0,0 +1,92 @@
+/*
+Author: godraadam @ utcn 2019
+Description: generic stack implementation using a fixed-size array stored inside the object as container
+			 capacity is a template parameter, no heap memory is ever allocated, so small stacks live on the
+			 call stack and every operation can be evaluated at compile time (T must be a literal type with
+			 a default constructor)
+			 overflowing the stack inside a constant expression is a compile error
+Operations: pop()  -> O(1)
+			push() -> O(1)
+			emplace() -> O(1)
+			peek() -> O(1)
+			empty()-> O(1)
+			full() -> O(1)
+			size() -> O(1)
+
+Example:	constexpr int sum() {
+				inlineStack<int, 8> s;
+				for (int i = 1; i <= 8; i++) s.push(i);
+				int total = 0;
+				while (!s.empty()) total += s.pop();
+				return total;
+			}
+			static_assert(sum() == 36);
+*/
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+template<class T, size_t max_size>
+
+class inlineStack final {
+
+	static_assert(max_size > 0, "Stack size must be positive!");
+
+	//Fields_______________________________________
+
+	//Pointer to the top of the stack
+	private: size_t head = 0;
+
+	//Container to actually store the items
+	private: T _stack[max_size]{};
+
+	//Methods______________________________________
+
+	//Default constructor
+	public: constexpr inlineStack() {}
+
+	//Returns true only if stack is empty
+	public: constexpr bool empty() {
+		return head == 0;
+	}
+
+	//Returns true only if stack is full
+	public: constexpr bool full() {
+		return head == max_size;
+	}
+
+	//Push item on top of stack
+	public: constexpr void push(T item) {
+		if (full()) throw std::length_error("Stack is full!");
+		_stack[head++] = std::move(item);
+	}
+
+	//Construct item on top of stack from the given arguments
+	public: template<class... Args> constexpr void emplace(Args&&... args) {
+		if (full()) throw std::length_error("Stack is full!");
+		_stack[head++] = T(std::forward<Args>(args)...);
+	}
+
+	//Pop item from top of stack and return it
+	public: constexpr T pop() {
+		if (empty()) throw std::length_error("Stack is empty!");
+		return std::move(_stack[--head]);
+	}
+
+	//Return item on top of stack, without removing it
+	public: constexpr T peek() {
+		if (empty()) throw std::length_error("Stack is empty!");
+		return _stack[head - 1];
+	}
+
+	//Returns current number of items in the stack
+	public: constexpr size_t size() {
+		return head;
+	}
+
+	//Return total number of items this stack can hold
+	public: constexpr size_t maxSize() {
+		return max_size;
+	}
+};
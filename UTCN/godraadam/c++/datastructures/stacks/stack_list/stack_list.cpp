@@ -1,14 +1,18 @@
 /*
 Author: godraadam @ utcn 2019
 Description: basic, generic stack implementation using single linked list as container
+			 nodes come from a per-stack slab allocator (allocators/slab), popped nodes are recycled through a freelist
 Operations: pop()  -> O(1)
-			push() -> O(1) 
+			push() -> O(1)
 			peek() -> O(1)
 			empty()-> O(1)
 			size() -> O(1)
 */
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
+#include "../../allocators/slab/slab.cpp"
 
 template <class T>
 
@@ -20,9 +24,7 @@ class stack final {
 		public:T item;
 		node* next = nullptr;
 
-		public: node(T item) {
-			this->item = item;
-		}
+		public: node(T item, node* next) : item(item), next(next) {}
 	};
 
 	//Handle to acces the stack
@@ -31,6 +33,25 @@ class stack final {
 	//Tracks current number of items on the stack
 	private: size_t _size = 0;
 
+	//Memory for the nodes
+	private: slab<node> pool;
+
+
+	//Default constructor
+	public: stack() {}
+
+	//Nodes are owned by the stack, copying it would free them twice
+	public: stack(const stack&) = delete;
+	public: stack& operator=(const stack&) = delete;
+
+	//Destructor, destroys the remaining items, the slab releases the memory
+	public: ~stack() {
+		while (head != nullptr) {
+			node* p = head;
+			head = p->next;
+			p->~node();
+		}
+	}
 
 	//Return true only if stack is empty
 	public: bool empty() {
@@ -44,11 +65,14 @@ class stack final {
 
 	//Push new item on top of stack
 	public: void push(T item) {
-		node* p = new node(item);
-		if (empty()) head = p;
-		else {
-			p->next = head;
-			head = p;
+		node* p = pool.allocate();
+		try {
+			head = new (p) node(item, head);
+		}
+		catch (...) {
+			//Copying the item threw, the slot goes back to the freelist
+			pool.deallocate(p);
+			throw;
 		}
 		_size++;
 	}
@@ -59,7 +83,7 @@ class stack final {
 		T ret = head->item;
 		node* p = head;
 		head = p->next;
-		free(p);
+		pool.release(p);
 		_size--;
 		return ret;
 	}
@@ -0,0 +1,225 @@
+/*
+Author: godraadam @ utcn 2019
+Description: lock-free, generic stack implementation (Treiber stack) using single linked list as container
+			 push and pop swap the head with compare-and-swap, popped nodes are reclaimed using hazard pointers:
+			 a node is only freed once no thread has it published as hazardous, so its address can not be
+			 reused while another thread still compares against it (no ABA problem)
+			 safe to use from any number of threads
+Operations: push()	  -> O(1)
+			pop()	  -> O(1) (amortized, occasional reclamation scan is O(threads^2))
+			try_pop() -> O(1) (amortized)
+			empty()	  -> O(1)
+			size()	  -> O(1) (approximate while other threads are modifying the stack)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+template <class T>
+
+class concurrentStack final {
+
+	//Helper class for linking data
+	private: class node {
+		public: T item;
+		public: node* next = nullptr;
+
+		//Link used only once the node has been popped and is waiting to be freed
+		public: node* retired_next = nullptr;
+
+		public: node(T item) : item(std::move(item)) {}
+	};
+
+	//Hazard pointer record, a thread publishes the node it is about to dereference here
+	//Records are never freed, a thread leaving gives its record up for reuse
+	private: struct hazard {
+		std::atomic<node*> pointer{ nullptr };
+		std::atomic<bool> active{ false };
+		hazard* next = nullptr;
+	};
+
+	//Per-thread reclamation state, shared between every stack of the same item type
+	private: struct threadState {
+		hazard* record = nullptr;
+		node* retired = nullptr;
+		size_t retired_count = 0;
+
+		//Give the record up and hand the nodes that are still hazardous to the other threads
+		~threadState() {
+			if (record == nullptr) return;
+			record->pointer.store(nullptr, std::memory_order_release);
+			scan(*this);
+			while (retired != nullptr) {
+				node* p = retired;
+				retired = p->retired_next;
+				p->retired_next = orphans.load(std::memory_order_relaxed);
+				while (!orphans.compare_exchange_weak(p->retired_next, p, std::memory_order_release, std::memory_order_relaxed));
+			}
+			record->active.store(false, std::memory_order_release);
+		}
+	};
+
+	//Fields_______________________________________
+
+	//Every hazard record ever created
+	private: inline static std::atomic<hazard*> hazards{ nullptr };
+
+	//Number of hazard records, bounds the number of retired nodes a thread keeps around
+	private: inline static std::atomic<size_t> hazard_count{ 0 };
+
+	//Retired nodes left behind by threads that have exited
+	private: inline static std::atomic<node*> orphans{ nullptr };
+
+	//Handle to acces the stack
+	private: std::atomic<node*> head{ nullptr };
+
+	//Tracks current number of items on the stack
+	private: std::atomic<size_t> _size{ 0 };
+
+	//Methods______________________________________
+
+	//Default constructor
+	public: concurrentStack() {}
+
+	public: concurrentStack(const concurrentStack&) = delete;
+	public: concurrentStack& operator=(const concurrentStack&) = delete;
+
+	//Destructor, must not run concurrently with any other operation on the stack
+	public: ~concurrentStack() {
+		node* p = head.load(std::memory_order_acquire);
+		while (p != nullptr) {
+			node* next = p->next;
+			delete p;
+			p = next;
+		}
+	}
+
+	//Return true only if stack is empty
+	public: bool empty() {
+		return head.load(std::memory_order_acquire) == nullptr;
+	}
+
+	//Returns current number of items on stack
+	public: size_t size() {
+		return _size.load(std::memory_order_relaxed);
+	}
+
+	//Push new item on top of stack
+	public: void push(T item) {
+		node* p = new node(std::move(item));
+		p->next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(p->next, p, std::memory_order_release, std::memory_order_relaxed));
+		_size.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//Pop the item from the top of the stack
+	//The item is moved straight out of its node, so T needs no default constructor
+	public: T pop() {
+		threadState& state = local();
+		node* old = unlink(state);
+		if (old == nullptr) throw std::length_error("Stack is empty!");
+		T ret = std::move(old->item);
+		retire(state, old);
+		return ret;
+	}
+
+	//Pop the item from the top of the stack into item, returns false if the stack was empty
+	public: bool try_pop(T& item) {
+		threadState& state = local();
+		node* old = unlink(state);
+		if (old == nullptr) return false;
+		item = std::move(old->item);
+		retire(state, old);
+		return true;
+	}
+
+	//Helpers______________________________________
+
+	//Take the top node off the stack, returns nullptr if the stack was empty
+	//The node stays allocated until it is retired
+	private: node* unlink(threadState& state) {
+		hazard* h = state.record;
+
+		node* old;
+		while (true) {
+			old = head.load(std::memory_order_acquire);
+			if (old == nullptr) break;
+
+			//Publish the node, then make sure it was not popped before it became visible as hazardous
+			h->pointer.store(old);
+			if (head.load() != old) continue;
+
+			if (head.compare_exchange_strong(old, old->next, std::memory_order_acq_rel, std::memory_order_relaxed)) break;
+		}
+		h->pointer.store(nullptr, std::memory_order_release);
+		if (old != nullptr) _size.fetch_sub(1, std::memory_order_relaxed);
+		return old;
+	}
+
+	//Returns the reclamation state of the calling thread, claiming a hazard record on first use
+	private: static threadState& local() {
+		static thread_local threadState state;
+		if (state.record == nullptr) state.record = acquireRecord();
+		return state;
+	}
+
+	//Reuse the record of an exited thread or create a new one
+	private: static hazard* acquireRecord() {
+		for (hazard* h = hazards.load(std::memory_order_acquire); h != nullptr; h = h->next) {
+			bool expected = false;
+			if (!h->active.load(std::memory_order_relaxed) &&
+				h->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) return h;
+		}
+
+		hazard* h = new hazard();
+		h->active.store(true, std::memory_order_relaxed);
+		h->next = hazards.load(std::memory_order_relaxed);
+		while (!hazards.compare_exchange_weak(h->next, h, std::memory_order_release, std::memory_order_relaxed));
+		hazard_count.fetch_add(1, std::memory_order_relaxed);
+		return h;
+	}
+
+	//Queue a popped node for deletion, reclaim the queue once it outgrows the number of hazard records
+	private: static void retire(threadState& state, node* p) {
+		p->retired_next = state.retired;
+		state.retired = p;
+		if (++state.retired_count >= 2 * hazard_count.load(std::memory_order_relaxed) + 16) scan(state);
+	}
+
+	//Delete every retired node that no thread has published as hazardous
+	private: static void scan(threadState& state) {
+		//Adopt the nodes of exited threads
+		node* adopted = orphans.exchange(nullptr, std::memory_order_acquire);
+		while (adopted != nullptr) {
+			node* p = adopted;
+			adopted = p->retired_next;
+			p->retired_next = state.retired;
+			state.retired = p;
+			state.retired_count++;
+		}
+
+		node* keep = nullptr;
+		size_t kept = 0;
+		while (state.retired != nullptr) {
+			node* p = state.retired;
+			state.retired = p->retired_next;
+			if (hazardous(p)) {
+				p->retired_next = keep;
+				keep = p;
+				kept++;
+			}
+			else delete p;
+		}
+		state.retired = keep;
+		state.retired_count = kept;
+	}
+
+	//Returns true only if some thread has published the given node
+	private: static bool hazardous(node* p) {
+		for (hazard* h = hazards.load(std::memory_order_acquire); h != nullptr; h = h->next)
+			if (h->pointer.load() == p) return true;
+		return false;
+	}
+};
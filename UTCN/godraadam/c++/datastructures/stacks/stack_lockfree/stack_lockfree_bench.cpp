@@ -0,0 +1,69 @@
+/*
+Author: godraadam @ utcn 2019
+Description: multi-threaded throughput benchmark of the lock-free stack against the list stack guarded by a mutex
+Build: g++ -O2 -std=c++17 -pthread stack_lockfree_bench.cpp -o stack_lockfree_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "stack_lockfree.cpp"
+#include "../stack_list/stack_list.cpp"
+
+//The list stack with every operation serialized by a single lock
+template <class T>
+
+class mutexStack final {
+
+	private: stack<T> _stack;
+	private: std::mutex lock;
+
+	public: void push(T item) {
+		std::lock_guard<std::mutex> guard(lock);
+		_stack.push(item);
+	}
+
+	public: bool try_pop(T& item) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (_stack.empty()) return false;
+		item = _stack.pop();
+		return true;
+	}
+};
+
+//Every thread alternates pushes and pops on the shared stack, returns millions of operations per second
+template <class S>
+static double throughput(size_t threads, size_t ops_per_thread) {
+	S s;
+	for (int i = 0; i < 1024; i++) s.push(i);
+
+	std::vector<std::thread> workers;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&s, ops_per_thread] {
+			int item = 0;
+			for (size_t i = 0; i < ops_per_thread; i++) {
+				s.push((int)i);
+				s.try_pop(item);
+			}
+		});
+	}
+	for (std::thread& w : workers) w.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return 2.0 * threads * ops_per_thread / seconds / 1e6;
+}
+
+int main() {
+	const size_t ops = 500000;
+	size_t max_threads = std::thread::hardware_concurrency();
+	if (max_threads < 16) max_threads = 16;
+
+	std::printf("%8s %16s %16s\n", "threads", "mutex (Mops/s)", "lock-free (Mops/s)");
+	for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+		std::printf("%8zu %16.2f %16.2f\n", threads,
+			throughput<mutexStack<int>>(threads, ops), throughput<concurrentStack<int>>(threads, ops));
+	}
+	return 0;
+}
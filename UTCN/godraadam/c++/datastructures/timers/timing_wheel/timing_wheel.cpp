@@ -0,0 +1,331 @@
+/*
+Author: godraadam @ utcn 2019
+Description: hierarchical timing wheel, holds timers carrying an item until a deadline and hands the item out once it passed
+			 time is counted in ticks of granularity time units, 4 wheels of 256 slots each cover 2^32 ticks,
+			 a timer goes into the wheel fine enough for its distance from the current tick,
+			 and is moved one wheel down whenever the wheel below turns over, later deadlines wait in an overflow list
+			 every slot is a doubly linked list of timers, so cancelling a timer only unlinks it
+			 timers are kept in one pool addressed by index, a handle is the index together with a generation
+			 counter, a handle of a timer that already fired or was cancelled is simply rejected
+			 advance() moves the timers that are due to a list of expired ones, drain() takes their items in batches
+			 while the lower wheels are empty, advance() jumps straight to the next turn of the first occupied wheel
+Operations: schedule() -> O(1) (amortized time)
+			cancel()   -> O(1)
+			advance()  -> O(1) per tick and per expired timer (amortized time, timers move down at most 3 times)
+			drain()    -> O(1) per item
+			size()     -> O(1)
+			expired()  -> O(1)
+			empty()    -> O(1)
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+template <class T>
+
+class timingWheel final {
+
+	//Wheel geometry, slots per wheel is 2^slot_bits
+	private: static const unsigned slot_bits = 8;
+	private: static const size_t slots = (size_t)1 << slot_bits;
+	private: static const uint64_t slot_mask = slots - 1;
+	private: static const size_t wheels = 4;
+
+	//Lists besides the slots: due timers waiting for drain(), timers beyond the last wheel, unused nodes
+	private: static const uint32_t expired_list = wheels * slots;
+	private: static const uint32_t overflow_list = expired_list + 1;
+	private: static const uint32_t free_list = overflow_list + 1;
+
+	//End of a list
+	private: static const uint32_t nil = UINT32_MAX;
+
+	//A timer, linked into the list it is in, the item is constructed only while the timer is in use
+	private: struct node {
+		uint64_t deadline;
+		uint32_t next;
+		uint32_t prev;
+		uint32_t list;
+		uint32_t generation;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* item() {
+			return reinterpret_cast<T*>(storage);
+		}
+	};
+
+	//Fields_______________________________________
+
+	//Time units per tick
+	private: uint64_t granularity;
+
+	//Last tick processed by advance()
+	private: uint64_t now = 0;
+
+	//Pool of timers
+	private: node* nodes = nullptr;
+	private: size_t _capacity = 0;
+
+	//First and last timer of every slot, the expired and the overflow list
+	private: uint32_t head[overflow_list + 1];
+	private: uint32_t tail[overflow_list + 1];
+
+	//Unused timers, a stack linked through next so the most recently released one is reused first
+	private: uint32_t free_head = nil;
+
+	//Number of timers in each wheel, the last counter is for the overflow list
+	private: size_t occupied[wheels + 1] = {};
+
+	//Number of timers scheduled and not yet due, number of due timers not yet drained
+	private: size_t pending = 0;
+	private: size_t due = 0;
+
+	//Methods______________________________________
+
+	//Constructor, ticks are granularity time units long and the wheel starts at time start
+	public: timingWheel(uint64_t granularity = 1, uint64_t start = 0) {
+		if (granularity == 0) throw std::invalid_argument("Invalid granularity!");
+		this->granularity = granularity;
+		now = start / granularity;
+		for (uint32_t i = 0; i <= overflow_list; i++) head[i] = tail[i] = nil;
+	}
+
+	//Timers are owned by the wheel, copying it would free them twice
+	public: timingWheel(const timingWheel&) = delete;
+	public: timingWheel& operator=(const timingWheel&) = delete;
+
+	//Destructor, destroys the items of every timer still in use
+	public: ~timingWheel() {
+		for (size_t i = 0; i < _capacity; i++)
+			if (nodes[i].list != free_list) nodes[i].item()->~T();
+		std::allocator<node>().deallocate(nodes, _capacity);
+	}
+
+	//Schedule item to be handed out delay time units from the current time, rounded up to a whole tick
+	//Returns a handle for cancel()
+	public: uint64_t schedule(uint64_t delay, T item) {
+		uint64_t ticks = delay / granularity + (delay % granularity != 0);
+		uint32_t index = take();
+		node& n = nodes[index];
+		new (n.storage) T(std::move(item));
+		n.deadline = now + (ticks > 0 ? ticks : 1);
+		place(index);
+		pending++;
+		return (uint64_t)n.generation << 32 | index;
+	}
+
+	//Cancel the timer with the given handle, also if it is due but not yet drained
+	//Returns false if the timer was already drained or cancelled
+	public: bool cancel(uint64_t handle) {
+		uint32_t index = (uint32_t)handle;
+		if (index >= _capacity) return false;
+		node& n = nodes[index];
+		if (n.list == free_list || n.generation != (uint32_t)(handle >> 32)) return false;
+		if (n.list == expired_list) due--;
+		else pending--;
+		unlink(index);
+		release(index);
+		return true;
+	}
+
+	//Advance the wheel to the given time, timers due by then are moved to the expired list
+	//Returns the number of timers that became due
+	public: size_t advance(uint64_t time) {
+		uint64_t target = time / granularity;
+		size_t before = due;
+		while (now < target) {
+			//Nothing scheduled, jump straight to the target tick
+			if (pending == 0) {
+				now = target;
+				break;
+			}
+
+			//Nothing happens before the first occupied wheel turns, skip to the tick before that
+			size_t wheel = 0;
+			while (occupied[wheel] == 0) wheel++;
+			if (wheel > 0) {
+				uint64_t turn = (now | (((uint64_t)1 << (slot_bits * wheel)) - 1)) + 1;
+				if (turn - 1 >= target) {
+					now = target;
+					break;
+				}
+				now = turn - 1;
+			}
+			now++;
+			size_t index = now & slot_mask;
+			if (index == 0) cascade();
+			expire(index);
+		}
+		return due - before;
+	}
+
+	//Move the items of up to max due timers into out, in the order they became due
+	//Returns the number of items moved
+	public: size_t drain(T* out, size_t max) {
+		size_t count = 0;
+		while (count < max && head[expired_list] != nil) {
+			uint32_t index = head[expired_list];
+			out[count++] = std::move(*nodes[index].item());
+			unlink(index);
+			release(index);
+			due--;
+		}
+		return count;
+	}
+
+	//Returns the number of timers scheduled and not yet due
+	public: size_t size() {
+		return pending;
+	}
+
+	//Returns the number of due timers waiting to be drained
+	public: size_t expired() {
+		return due;
+	}
+
+	//Returns true only if no timer is scheduled or waiting to be drained
+	public: bool empty() {
+		return pending == 0 && due == 0;
+	}
+
+	//Returns the current time, the start of the last processed tick
+	public: uint64_t time() {
+		return now * granularity;
+	}
+
+	//Helpers______________________________________
+
+	//Put a timer into the list that matches its distance from the current tick
+	private: void place(uint32_t index) {
+		uint64_t deadline = nodes[index].deadline;
+		uint64_t distance = deadline > now ? deadline - now : 0;
+		for (size_t wheel = 0; wheel < wheels; wheel++) {
+			if (distance < (uint64_t)1 << (slot_bits * (wheel + 1))) {
+				append(wheel * slots + ((deadline >> (slot_bits * wheel)) & slot_mask), index);
+				return;
+			}
+		}
+		append(overflow_list, index);
+	}
+
+	//The lowest wheel turned over, move the current slot of every wheel above that turned over too one wheel down
+	private: void cascade() {
+		for (size_t wheel = 1; wheel < wheels; wheel++) {
+			size_t index = (now >> (slot_bits * wheel)) & slot_mask;
+			replace(wheel * slots + index);
+			if (index != 0) return;
+		}
+		replace(overflow_list);
+	}
+
+	//Place every timer of the given list again
+	private: void replace(uint32_t list) {
+		uint32_t index = head[list];
+		head[list] = tail[list] = nil;
+		while (index != nil) {
+			uint32_t next = nodes[index].next;
+			track(list, -1);
+			place(index);
+			index = next;
+		}
+	}
+
+	//Move the timers of the given slot of the lowest wheel to the expired list
+	private: void expire(size_t slot) {
+		uint32_t index = head[slot];
+		if (index == nil) return;
+		size_t count = 0;
+		for (uint32_t i = index; i != nil; i = nodes[i].next) {
+			nodes[i].list = expired_list;
+			count++;
+		}
+
+		//Splice the whole slot onto the end of the expired list
+		if (tail[expired_list] == nil) head[expired_list] = index;
+		else nodes[tail[expired_list]].next = index;
+		nodes[index].prev = tail[expired_list];
+		tail[expired_list] = tail[slot];
+		head[slot] = tail[slot] = nil;
+		occupied[0] -= count;
+		pending -= count;
+		due += count;
+	}
+
+	//Add a timer at the end of a list
+	private: void append(uint32_t list, uint32_t index) {
+		node& n = nodes[index];
+		n.list = list;
+		n.next = nil;
+		n.prev = tail[list];
+		if (tail[list] == nil) head[list] = index;
+		else nodes[tail[list]].next = index;
+		tail[list] = index;
+		track(list, 1);
+	}
+
+	//Remove a timer from its list
+	private: void unlink(uint32_t index) {
+		node& n = nodes[index];
+		if (n.prev == nil) head[n.list] = n.next;
+		else nodes[n.prev].next = n.next;
+		if (n.next == nil) tail[n.list] = n.prev;
+		else nodes[n.next].prev = n.prev;
+		track(n.list, -1);
+	}
+
+	//Keep the number of timers in each wheel up to date when a timer enters or leaves a list
+	private: void track(uint32_t list, int delta) {
+		if (list < expired_list) occupied[list / slots] += delta;
+		else if (list == overflow_list) occupied[wheels] += delta;
+	}
+
+	//Returns an unused timer, growing the pool if there is none
+	private: uint32_t take() {
+		if (free_head == nil) grow();
+		uint32_t index = free_head;
+		free_head = nodes[index].next;
+		return index;
+	}
+
+	//Destroy the item of a timer that is no longer in any list and return it to the pool
+	//The generation changes, so handles to it are rejected from now on
+	private: void release(uint32_t index) {
+		nodes[index].item()->~T();
+		node& n = nodes[index];
+		n.generation++;
+		n.list = free_list;
+		n.next = free_head;
+		free_head = index;
+	}
+
+	//Double the pool, moving the items of the timers in use
+	private: void grow() {
+		size_t capacity = _capacity == 0 ? 64 : _capacity * 2;
+		if (capacity >= nil) throw std::length_error("Too many timers!");
+		node* _nodes = std::allocator<node>().allocate(capacity);
+		for (size_t i = 0; i < _capacity; i++) {
+			node& n = _nodes[i];
+			n.deadline = nodes[i].deadline;
+			n.next = nodes[i].next;
+			n.prev = nodes[i].prev;
+			n.list = nodes[i].list;
+			n.generation = nodes[i].generation;
+			if (n.list != free_list) {
+				new (n.storage) T(std::move(*nodes[i].item()));
+				nodes[i].item()->~T();
+			}
+		}
+		std::allocator<node>().deallocate(nodes, _capacity);
+		nodes = _nodes;
+		for (size_t i = capacity; i-- > _capacity;) {
+			nodes[i].generation = 0;
+			nodes[i].list = free_list;
+			nodes[i].next = free_head;
+			free_head = (uint32_t)i;
+		}
+		_capacity = capacity;
+	}
+};
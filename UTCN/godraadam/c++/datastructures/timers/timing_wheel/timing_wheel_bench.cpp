@@ -0,0 +1,110 @@
+/*
+Author: godraadam @ utcn 2019
+Description: connection timeout churn, the timing wheel against minHeap
+			 every connection has a 30 s timeout that is pushed back whenever it is active,
+			 connections are active every 5 s on average, so almost every timeout is cancelled before it fires
+			 a timeout that does fire is scheduled again, time advances in 1 ms ticks for 100 s
+			 minHeap cannot cancel, every reschedule pushes a new entry and stale ones are skipped when they come up
+Build: g++ -O2 -std=c++17 timing_wheel_bench.cpp -o timing_wheel_bench
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../../heaps/binary_min_heap/binary_min_heap.cpp"
+#include "timing_wheel.cpp"
+
+static const uint64_t timeout = 30000;
+static const uint64_t duration = 100000;
+static const uint64_t activity = 5000;
+
+struct result {
+	double ms = 0;
+	size_t reschedules = 0;
+	size_t fired = 0;
+	size_t peak = 0;
+};
+
+//Heap entry, stale once the connection was rescheduled after it was pushed
+struct entry {
+	uint64_t deadline;
+	uint32_t connection;
+	uint32_t version;
+
+	bool operator>(const entry& o) const { return deadline > o.deadline; }
+};
+
+static result heap(size_t connections) {
+	result r;
+	std::mt19937_64 rng(1);
+	auto start = std::chrono::steady_clock::now();
+
+	minHeap<entry> timers;
+	std::vector<uint32_t> version(connections, 0);
+	for (uint32_t c = 0; c < connections; c++) timers.push({ timeout, c, 0 });
+
+	size_t per_tick = connections / activity;
+	for (uint64_t now = 1; now <= duration; now++) {
+		for (size_t i = 0; i < per_tick; i++) {
+			uint32_t c = (uint32_t)(rng() % connections);
+			timers.push({ now + timeout, c, ++version[c] });
+			r.reschedules++;
+		}
+		while (!timers.empty() && timers.peek().deadline <= now) {
+			entry e = timers.pop();
+			if (e.version != version[e.connection]) continue;
+			r.fired++;
+			timers.push({ now + timeout, e.connection, ++version[e.connection] });
+		}
+		if (timers.size() > r.peak) r.peak = timers.size();
+	}
+
+	r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return r;
+}
+
+static result wheel(size_t connections) {
+	result r;
+	std::mt19937_64 rng(1);
+	auto start = std::chrono::steady_clock::now();
+
+	timingWheel<uint32_t> timers(1);
+	std::vector<uint64_t> handle(connections);
+	for (uint32_t c = 0; c < connections; c++) handle[c] = timers.schedule(timeout, c);
+
+	uint32_t batch[256];
+	size_t per_tick = connections / activity;
+	for (uint64_t now = 1; now <= duration; now++) {
+		//Timers that came due this tick can still be cancelled until they are drained
+		timers.advance(now);
+		for (size_t i = 0; i < per_tick; i++) {
+			uint32_t c = (uint32_t)(rng() % connections);
+			timers.cancel(handle[c]);
+			handle[c] = timers.schedule(timeout, c);
+			r.reschedules++;
+		}
+		size_t count;
+		while ((count = timers.drain(batch, 256)) > 0) {
+			for (size_t i = 0; i < count; i++) handle[batch[i]] = timers.schedule(timeout, batch[i]);
+			r.fired += count;
+		}
+		if (timers.size() > r.peak) r.peak = timers.size();
+	}
+
+	r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return r;
+}
+
+static void print(const char* name, size_t connections, const result& r) {
+	std::printf("%-12s %12zu %10.1f %12zu %10zu %12zu\n", name, connections, r.ms, r.reschedules, r.fired, r.peak);
+}
+
+int main() {
+	std::printf("%-12s %12s %10s %12s %10s %12s\n", "timers", "connections", "time (ms)", "reschedules", "fired", "peak size");
+	for (size_t connections : { 100000, 1000000 }) {
+		print("minHeap", connections, heap(connections));
+		print("timingWheel", connections, wheel(connections));
+	}
+	return 0;
+}